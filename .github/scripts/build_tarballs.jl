@@ -24,6 +24,8 @@ const sources = [
 const dependencies = [
     "CGAL_jll",
     "libcxxwrap_julia_jll",
+    # batch operations run in parallel when TBB is found
+    "TBB_jll",
 ]
 
 # Bash recipe for building across all platforms
@@ -48,7 +50,10 @@ cmake ../ \
   -DCMAKE_FIND_ROOT_PATH="$prefix" \
   -DCMAKE_INSTALL_PREFIX="$prefix" \
   `# tell libcxxwrap-julia where julia is` \
-  -DJulia_PREFIX="$Julia_PREFIX"
+  -DJulia_PREFIX="$Julia_PREFIX" \
+  `# parallel batch operations` \
+  -DJLCGAL_WITH_TBB=ON \
+  -DTBB_ROOT="$prefix"
 
 ## and away we go..
 VERBOSE=ON cmake --build . --config Release --target install -- -j$nproc
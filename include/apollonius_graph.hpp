@@ -0,0 +1,253 @@
+#ifndef CGAL_JL_APOLLONIUS_GRAPH_HPP
+#define CGAL_JL_APOLLONIUS_GRAPH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <CGAL/Apollonius_graph_2.h>
+#include <CGAL/Apollonius_graph_hierarchy_2.h>
+#include <CGAL/Apollonius_graph_traits_2.h>
+
+#include "kernel.hpp"
+#include "parallel.hpp"
+#include "utils.hpp"
+#include "voronoi_cells.hpp"
+
+namespace jlcgal {
+
+typedef CGAL::Apollonius_graph_traits_2<Kernel>      Ag_gt_2;
+typedef CGAL::Apollonius_graph_2<Ag_gt_2>            AG_2;
+typedef CGAL::Apollonius_graph_hierarchy_2<Ag_gt_2>  AGH_2;
+
+typedef Ag_gt_2::Site_2 Apollonius_site_2;
+
+// Traces additively weighted Voronoi cells, which are star-shaped around
+// their site's center, through their distance r(θ) from the center along
+// direction θ.  Hyperbolic arcs are sampled adaptively, until chords are
+// within `tolerance` of the arc, and unbounded parts are cut by a box well
+// beyond the clipping rectangle.  Coordinates are relative to the center.
+class Apollonius_tracer_2 {
+public:
+  struct Site {
+    double x, y, w;
+  };
+
+  Apollonius_tracer_2(const Site& s, const double tolerance,
+                      const double xmin, const double xmax,
+                      const double ymin, const double ymax)
+    : _s(s), _tolerance(tolerance),
+      _xmin(xmin - s.x), _xmax(xmax - s.x), _ymin(ymin - s.y), _ymax(ymax - s.y) {}
+
+  std::vector<Site> neighbors;
+
+  // Distance to the boundary shared with n along direction θ, infinite
+  // where the direction does not reach it.
+  double bisector_distance(const Site& n, const double theta) const {
+    const double vx = _s.x - n.x, vy = _s.y - n.y, d = n.w - _s.w;
+    const double den = d - (vx * std::cos(theta) + vy * std::sin(theta));
+    if (!(den > 0)) return std::numeric_limits<double>::infinity();
+    return (vx * vx + vy * vy - d * d) / (2 * den);
+  }
+
+  // Directions where the boundary shared with n goes to infinity, the
+  // boundary being reached in between, counterclockwise.
+  void asymptotes(const Site& n, double& first, double& last) const {
+    const double vx = _s.x - n.x, vy = _s.y - n.y, d = n.w - _s.w;
+    const double phi = std::atan2(vy, vx),
+                 a = std::acos(std::max(-1., std::min(1., d / std::hypot(vx, vy))));
+    first = phi + a;
+    last  = phi + 2 * CGAL_PI - a;
+  }
+
+  double box_distance(const double theta) const {
+    const double ux = std::cos(theta), uy = std::sin(theta);
+    double r = std::numeric_limits<double>::infinity();
+    if (ux > 0) r = std::min(r, _xmax / ux);
+    if (ux < 0) r = std::min(r, _xmin / ux);
+    if (uy > 0) r = std::min(r, _ymax / uy);
+    if (uy < 0) r = std::min(r, _ymin / uy);
+    return r;
+  }
+
+  // Directions of the box corners, where its boundary bends.
+  std::vector<double> box_corners() const {
+    return {std::atan2(_ymin, _xmin), std::atan2(_ymin, _xmax),
+            std::atan2(_ymax, _xmax), std::atan2(_ymax, _xmin)};
+  }
+
+  double angle(const Point_2& p) const {
+    return std::atan2(CGAL::to_double(p.y()) - _s.y,
+                      CGAL::to_double(p.x()) - _s.x);
+  }
+
+  // Appends the points of the boundary for θ in (first, last], where
+  // r(θ) = f(θ) is bounded by the box.
+  template<typename F>
+  void trace(const double first, const double last, const F& f,
+             Cell_2& out) const {
+    trace(first, point(first, f), last, point(last, f), f, 0, out);
+  }
+
+  template<typename F>
+  Cell_point_2 point(const double theta, const F& f) const {
+    const double r = std::min(box_distance(theta), f(theta));
+    return {{r * std::cos(theta), r * std::sin(theta)}};
+  }
+
+private:
+  template<typename F>
+  void trace(const double ta, const Cell_point_2& pa,
+             const double tb, const Cell_point_2& pb, const F& f,
+             const int depth, Cell_2& out) const {
+    const double tm = (ta + tb) / 2;
+    const Cell_point_2 pm = point(tm, f);
+    const double cx = pb[0] - pa[0], cy = pb[1] - pa[1],
+                 mx = pm[0] - pa[0], my = pm[1] - pa[1],
+                 chord = std::hypot(cx, cy);
+    const double dev = chord > 0 ? std::abs(cx * my - cy * mx) / chord
+                                 : std::hypot(mx, my);
+    if (dev > _tolerance && depth < 24) {
+      trace(ta, pa, tm, pm, f, depth + 1, out);
+      trace(tm, pm, tb, pb, f, depth + 1, out);
+    } else {
+      out.push_back(pb);
+    }
+  }
+
+  Site _s;
+  double _tolerance, _xmin, _xmax, _ymin, _ymax;
+};
+
+// Traces the cells and bisectors of an Apollonius graph, cut by a box
+// around both the clipping rectangle and the sites.
+template<typename AG>
+class Apollonius_diagram_tracer_2 {
+public:
+  typedef Apollonius_tracer_2::Site Site;
+
+  Apollonius_diagram_tracer_2(const AG& ag, const Iso_rectangle_2& clip,
+                              const double tolerance)
+    : _ag(ag), _tolerance(tolerance) {
+    if (!(tolerance > 0)) {
+      throw std::invalid_argument("tolerance must be positive");
+    }
+    _xmin = CGAL::to_double(clip.xmin()); _xmax = CGAL::to_double(clip.xmax());
+    _ymin = CGAL::to_double(clip.ymin()); _ymax = CGAL::to_double(clip.ymax());
+    _cxmin = _xmin; _cxmax = _xmax; _cymin = _ymin; _cymax = _ymax;
+    for (auto v = ag.finite_vertices_begin(); v != ag.finite_vertices_end(); ++v) {
+      const Site s = site(v);
+      _xmin = std::min(_xmin, s.x); _xmax = std::max(_xmax, s.x);
+      _ymin = std::min(_ymin, s.y); _ymax = std::max(_ymax, s.y);
+    }
+    const double m = std::max({_xmax - _xmin, _ymax - _ymin, 1.});
+    _xmin -= m; _xmax += m; _ymin -= m; _ymax += m;
+  }
+
+  static Site site(const typename AG::Vertex_handle v) {
+    return {CGAL::to_double(v->site().point().x()),
+            CGAL::to_double(v->site().point().y()),
+            CGAL::to_double(v->site().weight())};
+  }
+
+  Apollonius_tracer_2 tracer(const Site& s) const {
+    return Apollonius_tracer_2(s, _tolerance, _xmin, _xmax, _ymin, _ymax);
+  }
+
+  // The cell of v clipped to the rectangle, counterclockwise.
+  Cell_2 cell(const typename AG::Vertex_handle v) const {
+    const Site s = site(v);
+    Apollonius_tracer_2 tr = tracer(s);
+    std::vector<double> thetas = tr.box_corners();
+    if (_ag.dimension() > 0) {
+      auto vc = _ag.incident_vertices(v), vdone = vc;
+      do {
+        if (!_ag.is_infinite(vc)) tr.neighbors.push_back(site(vc));
+      } while (++vc != vdone);
+    }
+    if (_ag.dimension() == 2) {
+      auto fc = _ag.incident_faces(v), fdone = fc;
+      do {
+        if (!_ag.is_infinite(fc)) thetas.push_back(tr.angle(_ag.dual(fc)));
+      } while (++fc != fdone);
+    }
+    std::sort(thetas.begin(), thetas.end());
+
+    auto r = [&tr](const double theta) {
+      double d = std::numeric_limits<double>::infinity();
+      for (const Site& n : tr.neighbors) {
+        d = std::min(d, tr.bisector_distance(n, theta));
+      }
+      return d;
+    };
+    Cell_2 poly;
+    for (std::size_t k = 0; k < thetas.size(); ++k) {
+      const double next = k + 1 < thetas.size() ? thetas[k + 1]
+                                                : thetas[0] + 2 * CGAL_PI;
+      if (next > thetas[k]) tr.trace(thetas[k], next, r, poly);
+    }
+
+    clip_cell(poly, {{-1.,  0.}}, s.x - _cxmin);
+    clip_cell(poly, {{ 1.,  0.}}, _cxmax - s.x);
+    clip_cell(poly, {{ 0., -1.}}, s.y - _cymin);
+    clip_cell(poly, {{ 0.,  1.}}, _cymax - s.y);
+    for (Cell_point_2& p : poly) {
+      p[0] += s.x;
+      p[1] += s.y;
+    }
+    return poly;
+  }
+
+  std::vector<Cell_2> cells() const {
+    const std::vector<typename AG::Vertex_handle> vhs = vertex_handles(_ag);
+    std::vector<Cell_2> res(vhs.size());
+    parallel_for(vhs.size(), [&](const std::size_t i) { res[i] = cell(vhs[i]); });
+    return res;
+  }
+
+  // The bisectors of the finite edges, clipped to the rectangle.
+  std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>>
+  bisectors() const {
+    Polyline_clipper_2 out(Iso_rectangle_2(_cxmin, _cymin, _cxmax, _cymax));
+    for (auto it = _ag.finite_edges_begin(); it != _ag.finite_edges_end(); ++it) {
+      const auto f = it->first, g = f->neighbor(it->second);
+      const Site s = site(f->vertex(AG::ccw(it->second))),
+                 n = site(f->vertex(AG::cw(it->second)));
+      const Apollonius_tracer_2 tr = tracer(s);
+
+      // The edge runs counterclockwise around s, from the dual of g to
+      // the dual of f.
+      double first, last;
+      tr.asymptotes(n, first, last);
+      if (!_ag.is_infinite(g)) first = tr.angle(_ag.dual(g));
+      if (!_ag.is_infinite(f)) last = tr.angle(_ag.dual(f));
+      while (last < first) last += 2 * CGAL_PI;
+      if (last == first) continue;
+
+      auto r = [&tr, &n](const double theta) {
+        return tr.bisector_distance(n, theta);
+      };
+      Cell_2 pts(1, tr.point(first, r));
+      tr.trace(first, last, r, pts);
+      for (std::size_t k = 0; k + 1 < pts.size(); ++k) {
+        out.add(s.x + pts[k][0],     s.y + pts[k][1],
+                s.x + pts[k + 1][0], s.y + pts[k + 1][1]);
+      }
+      out.close();
+    }
+    return out.result();
+  }
+
+private:
+  const AG& _ag;
+  double _tolerance;
+  double _xmin, _xmax, _ymin, _ymax, _cxmin, _cxmax, _cymin, _cymax;
+};
+
+} // jlcgal
+
+#endif // CGAL_JL_APOLLONIUS_GRAPH_HPP
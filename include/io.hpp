@@ -2,6 +2,7 @@
 #define CGAL_JL_IO_HPP
 
 #include <sstream>
+#include <string>
 
 #include <CGAL/IO/io.h>
 
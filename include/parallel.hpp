@@ -0,0 +1,48 @@
+#ifndef CGAL_JL_PARALLEL_HPP
+#define CGAL_JL_PARALLEL_HPP
+
+#include <cstddef>
+
+#include <CGAL/config.h>
+
+// Batch operations run on TBB's thread pool when CGAL was linked against it.
+// The exact constructions kernel's lazy number types share reference-counted
+// representations that are not thread-safe, so it always runs sequentially.
+#if defined(CGAL_LINKED_WITH_TBB) && !defined(JLCGAL_EXACT_CONSTRUCTIONS)
+#define JLCGAL_PARALLEL
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace jlcgal {
+
+// Calls f(i) for every i in [0, n).  f must not touch julia-managed memory
+// other than reading from arrays.
+template<typename F>
+void
+parallel_for(const std::size_t n, const F& f) {
+#ifdef JLCGAL_PARALLEL
+  tbb::parallel_for(std::size_t(0), n, f);
+#else
+  for (std::size_t i = 0; i < n; ++i) f(i);
+#endif
+}
+
+// Calls f(begin, end) over disjoint subranges covering [0, n), e.g., so that
+// consecutive queries may reuse each other as hints.
+template<typename F>
+void
+parallel_for_ranges(const std::size_t n, const F& f) {
+#ifdef JLCGAL_PARALLEL
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n),
+                    [&f](const tbb::blocked_range<std::size_t>& r) {
+    f(r.begin(), r.end());
+  });
+#else
+  f(0, n);
+#endif
+}
+
+} // jlcgal
+
+#endif // CGAL_JL_PARALLEL_HPP
@@ -1,3 +1,8 @@
+#ifndef CGAL_JL_POLYGON_2_HPP
+#define CGAL_JL_POLYGON_2_HPP
+
+#include <vector>
+
 #include <CGAL/Polygon_2.h>
 #include <CGAL/Polygon_with_holes_2.h>
 
@@ -8,4 +13,10 @@ namespace jlcgal {
 typedef CGAL::Polygon_2<Kernel>            Polygon_2;
 typedef CGAL::Polygon_with_holes_2<Kernel> Polygon_with_holes_2;
 
+// Natively held polygons, e.g., bulk loaded from flat buffers, which
+// polygon batch operations take as they are.
+struct Polygon_collection_2 : std::vector<Polygon_with_holes_2> {};
+
 } // jlcgal
+
+#endif // CGAL_JL_POLYGON_2_HPP
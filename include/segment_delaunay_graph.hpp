@@ -0,0 +1,67 @@
+#ifndef CGAL_JL_SEGMENT_DELAUNAY_GRAPH_HPP
+#define CGAL_JL_SEGMENT_DELAUNAY_GRAPH_HPP
+
+#include <CGAL/Segment_Delaunay_graph_2.h>
+#include <CGAL/Segment_Delaunay_graph_filtered_traits_2.h>
+#include <CGAL/Segment_Delaunay_graph_hierarchy_2.h>
+#include <CGAL/Simple_cartesian.h>
+
+#include "kernel.hpp"
+#include "kernel_conversion.hpp"
+
+namespace jlcgal {
+
+// Segment Delaunay graphs come with their own filtered traits, which
+// evaluate predicates exactly on double coordinates and support
+// intersecting segments.
+typedef CGAL::Simple_cartesian<double>                             Sdg_kernel;
+typedef CGAL::Segment_Delaunay_graph_filtered_traits_2<Sdg_kernel> Sdg_gt_2;
+typedef CGAL::Segment_Delaunay_graph_2<Sdg_gt_2>                   SDG_2;
+typedef CGAL::Segment_Delaunay_graph_hierarchy_2<Sdg_gt_2>         SDGH_2;
+
+typedef Sdg_gt_2::Line_2    Sdg_line_2;
+typedef Sdg_gt_2::Point_2   Sdg_point_2;
+typedef Sdg_gt_2::Ray_2     Sdg_ray_2;
+typedef Sdg_gt_2::Segment_2 Sdg_segment_2;
+typedef Sdg_gt_2::Site_2    Sdg_site_2;
+
+template<>
+struct To_linear<Sdg_point_2> {
+  Point_2 operator()(const Sdg_point_2& p) const {
+    Point_2 lp(p.x(), p.y());
+    return lp;
+  }
+};
+
+template<>
+struct To_linear<Sdg_segment_2> {
+  Segment_2 operator()(const Sdg_segment_2& s) const {
+    To_linear<Sdg_point_2> p2l;
+    Segment_2 ls(p2l(s.source()), p2l(s.target()));
+    return ls;
+  }
+};
+
+// Given a segment Delaunay graph object of type T, it converts a linear
+// kernel object to its segment Delaunay graph counterpart, rounding to
+// doubles, or one identical to it.
+// Typical usage: To_sdg<SdgType>()(LinearType) -> SdgType.
+// Default is just the identity operation.
+template<typename T>
+struct To_sdg {
+  const T& operator()(const T& t) const {
+    return t;
+  }
+};
+
+template<>
+struct To_sdg<Sdg_point_2> {
+  Sdg_point_2 operator()(const Point_2& p) const {
+    Sdg_point_2 sp(CGAL::to_double(p.x()), CGAL::to_double(p.y()));
+    return sp;
+  }
+};
+
+} // jlcgal
+
+#endif // CGAL_JL_SEGMENT_DELAUNAY_GRAPH_HPP
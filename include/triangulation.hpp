@@ -1,16 +1,27 @@
 #ifndef CGAL_JL_TRIANGULATION_HPP
 #define CGAL_JL_TRIANGULATION_HPP
 
+#include <cstddef>
+#include <unordered_map>
+
+#include <CGAL/Handle_hash_function.h>
+#include <CGAL/Interval_nt.h>
+#include <CGAL/Simple_cartesian.h>
 #include <CGAL/Triangulation_2.h>
 
 #include <CGAL/Constrained_triangulation_2.h>
 #include <CGAL/Constrained_Delaunay_triangulation_2.h>
 
 #include <CGAL/Delaunay_triangulation_2.h>
+#include <CGAL/Triangulation_vertex_base_with_info_2.h>
 
 #include <CGAL/Regular_triangulation_2.h>
 
+#include <CGAL/Triangulation_hierarchy_2.h>
+#include <CGAL/Triangulation_hierarchy_vertex_base_2.h>
+
 #include "kernel.hpp"
+#include "utils.hpp"
 
 namespace jlcgal {
 
@@ -21,8 +32,63 @@ typedef CGAL::Constrained_Delaunay_triangulation_2<Kernel> CDTr_2;
 
 typedef CGAL::Delaunay_triangulation_2<Kernel> DTr_2;
 
+// Delaunay triangulation whose vertices remember their index in the input.
+typedef CGAL::Triangulation_vertex_base_with_info_2<std::size_t, Kernel> Indexed_vb_2;
+typedef CGAL::Triangulation_data_structure_2<Indexed_vb_2>              Indexed_tds_2;
+typedef CGAL::Delaunay_triangulation_2<Kernel, Indexed_tds_2>           Indexed_DTr_2;
+
 typedef CGAL::Regular_triangulation_2<Kernel> RTr_2;
 
+typedef CGAL::Triangulation_hierarchy_vertex_base_2<
+  CGAL::Triangulation_vertex_base_2<Kernel>> Hierarchy_vb_2;
+
+typedef CGAL::Triangulation_data_structure_2<Hierarchy_vb_2> DH_tds_2;
+typedef CGAL::Triangulation_hierarchy_2<
+  CGAL::Delaunay_triangulation_2<Kernel, DH_tds_2>> DHTr_2;
+
+typedef CGAL::Triangulation_data_structure_2<Hierarchy_vb_2
+  , CGAL::Constrained_triangulation_face_base_2<Kernel>> CDH_tds_2;
+typedef CGAL::Triangulation_hierarchy_2<
+  CGAL::Constrained_Delaunay_triangulation_2<Kernel, CDH_tds_2>> CDHTr_2;
+
+// Faces are referred to by their position in the all face iteration order,
+// infinite faces included, i.e., the order in which `all_faces` lists them.
+template<typename T>
+std::unordered_map<typename T::Face_handle, std::size_t, CGAL::Handle_hash_function>
+all_face_indices(const T& t) {
+  std::unordered_map<typename T::Face_handle, std::size_t,
+                     CGAL::Handle_hash_function> idx;
+  std::size_t i = 0;
+  for (auto it = t.all_faces_begin(); it != t.all_faces_end(); ++it) {
+    idx.emplace(it, i++);
+  }
+  return idx;
+}
+
+// Bounding box of the circumcircle of a finite face, computed with interval
+// arithmetic so that it contains the exact circle: rounded circumcenters and
+// radii would let circles grazing a boundary seem to stay clear of it.
+// Nearly degenerate faces get an unbounded box.
+template<typename Face_handle>
+Bbox_2
+circumcircle_bbox(const Face_handle f) {
+  typedef CGAL::Simple_cartesian<CGAL::Interval_nt<>> Ik;
+  Ik::Point_2 ps[3];
+  for (int i = 0; i < 3; ++i) {
+    const Point_2& p = f->vertex(i)->point();
+    ps[i] = Ik::Point_2(Ik::FT(CGAL::to_interval(p.x())),
+                        Ik::FT(CGAL::to_interval(p.y())));
+  }
+  const Ik::Point_2 c = CGAL::circumcenter(ps[0], ps[1], ps[2]);
+  const Ik::FT r = CGAL::sqrt(CGAL::squared_distance(c, ps[0]));
+  return Bbox_2((c.x() - r).inf(), (c.y() - r).inf(),
+                (c.x() + r).sup(), (c.y() + r).sup());
+}
+
+// The unweighted point of a triangulation vertex, regular or not.
+inline const Point_2& bare_point(const Point_2& p)          { return p; }
+inline const Point_2& bare_point(const Weighted_point_2& p) { return p.point(); }
+
 } // jlcgal
 
 #endif // CGAL_JL_TRIANGULATION_HPP
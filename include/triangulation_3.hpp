@@ -0,0 +1,41 @@
+#ifndef CGAL_JL_TRIANGULATION_3_HPP
+#define CGAL_JL_TRIANGULATION_3_HPP
+
+#include <CGAL/Delaunay_triangulation_3.h>
+#include <CGAL/Delaunay_triangulation_cell_base_3.h>
+#include <CGAL/Regular_triangulation_3.h>
+#include <CGAL/Regular_triangulation_cell_base_3.h>
+#include <CGAL/Regular_triangulation_vertex_base_3.h>
+#include <CGAL/Triangulation_data_structure_3.h>
+#include <CGAL/Triangulation_vertex_base_3.h>
+
+#include "kernel.hpp"
+#include "parallel.hpp"
+
+#ifdef JLCGAL_PARALLEL
+#include <CGAL/Spatial_lock_grid_3.h>
+#endif
+
+namespace jlcgal {
+
+#ifdef JLCGAL_PARALLEL
+typedef CGAL::Parallel_tag   Concurrency_tag;
+#else
+typedef CGAL::Sequential_tag Concurrency_tag;
+#endif
+
+typedef CGAL::Triangulation_data_structure_3<
+    CGAL::Triangulation_vertex_base_3<Kernel>
+  , CGAL::Delaunay_triangulation_cell_base_3<Kernel>
+  , Concurrency_tag>                                   DTds_3;
+typedef CGAL::Delaunay_triangulation_3<Kernel, DTds_3> DTr_3;
+
+typedef CGAL::Triangulation_data_structure_3<
+    CGAL::Regular_triangulation_vertex_base_3<Kernel>
+  , CGAL::Regular_triangulation_cell_base_3<Kernel>
+  , Concurrency_tag>                                   RTds_3;
+typedef CGAL::Regular_triangulation_3<Kernel, RTds_3>  RTr_3;
+
+} // jlcgal
+
+#endif // CGAL_JL_TRIANGULATION_3_HPP
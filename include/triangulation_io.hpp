@@ -0,0 +1,441 @@
+#ifndef CGAL_JL_TRIANGULATION_IO_HPP
+#define CGAL_JL_TRIANGULATION_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <CGAL/Handle_hash_function.h>
+#include <CGAL/Regular_triangulation_2.h>
+#include <CGAL/Triangulation_hierarchy_2.h>
+
+#include "kernel.hpp"
+
+namespace jlcgal {
+
+// Binary layout of a 2D triangulation, in native byte order:
+//
+//   char[8]   magic "JLCGTR2\0"
+//   uint32    format version
+//   uint32    flags: 1 if points are weighted, 2 if faces have constraints
+//   int32     dimension
+//   uint64    nv, the number of vertices, the infinite one excluded
+//   double    nv times x, y (and weight), coordinates rounded to doubles
+//   uint8     nv hidden flags (regular triangulations only)
+//   uint64    nv vertex faces, indices into the faces
+//   uint64    nf, the number of faces, infinite ones included
+//   uint64    3 nf face vertices: 0 for the infinite vertex, i for the i-th
+//             vertex
+//   uint64    3 nf face neighbors, indices into the faces
+//   uint8     3 nf constraint flags (constrained triangulations only)
+//
+// Missing vertices and neighbors (of faces of lower dimensional
+// triangulations) are TRIANGULATION_IO_NONE.  Vertices are in the data
+// structure's order, so that vertex indices survive a round trip.
+const char          TRIANGULATION_IO_MAGIC[8] = "JLCGTR2";
+const std::uint32_t TRIANGULATION_IO_VERSION  = 1;
+const std::uint32_t TRIANGULATION_IO_WEIGHTED    = 1;
+const std::uint32_t TRIANGULATION_IO_CONSTRAINED = 2;
+const std::uint64_t TRIANGULATION_IO_NONE =
+  std::numeric_limits<std::uint64_t>::max();
+
+struct Triangulation_data_2 {
+  std::uint32_t flags = 0;
+  std::int32_t dimension = -1;
+  std::vector<double> coords;
+  std::vector<std::uint8_t> hidden;
+  std::vector<std::uint64_t> vertex_faces, face_vertices, face_neighbors;
+  std::vector<std::uint8_t> constraints;
+
+  std::size_t point_size() const {
+    return flags & TRIANGULATION_IO_WEIGHTED ? 3 : 2;
+  }
+  std::size_t number_of_vertices() const { return vertex_faces.size(); }
+  std::size_t number_of_faces() const { return face_vertices.size() / 3; }
+};
+
+// Points, weights and faces' extras, which depend on the triangulation.
+inline void
+write_point(const Point_2& p, Triangulation_data_2& d) {
+  d.coords.push_back(CGAL::to_double(p.x()));
+  d.coords.push_back(CGAL::to_double(p.y()));
+}
+
+inline void
+write_point(const Weighted_point_2& p, Triangulation_data_2& d) {
+  write_point(p.point(), d);
+  d.coords.push_back(CGAL::to_double(p.weight()));
+}
+
+inline void
+read_point(const double* c, Point_2& p) {
+  p = Point_2(c[0], c[1]);
+}
+
+inline void
+read_point(const double* c, Weighted_point_2& p) {
+  p = Weighted_point_2(Point_2(c[0], c[1]), c[2]);
+}
+
+inline std::uint32_t point_flags(const Point_2&)          { return 0; }
+inline std::uint32_t point_flags(const Weighted_point_2&) {
+  return TRIANGULATION_IO_WEIGHTED;
+}
+
+template<typename V>
+auto
+write_hidden(const V& v, Triangulation_data_2& d, int)
+  -> decltype(v.is_hidden(), void()) {
+  d.hidden.push_back(v.is_hidden());
+}
+
+template<typename V>
+void write_hidden(const V&, Triangulation_data_2&, long) {}
+
+template<typename F>
+auto
+constraint_flags(const F& f, int) -> decltype(f.is_constrained(0), std::uint32_t()) {
+  return TRIANGULATION_IO_CONSTRAINED;
+}
+
+template<typename F>
+std::uint32_t constraint_flags(const F&, long) { return 0; }
+
+template<typename F>
+auto
+write_constraints(const F& f, Triangulation_data_2& d, int)
+  -> decltype(f.is_constrained(0), void()) {
+  for (int i = 0; i < 3; ++i) d.constraints.push_back(f.is_constrained(i));
+}
+
+template<typename F>
+void write_constraints(const F&, Triangulation_data_2&, long) {}
+
+template<typename F>
+auto
+read_constraints(F& f, const std::uint8_t* c, int)
+  -> decltype(f.set_constraint(0, true), void()) {
+  for (int i = 0; i < 3; ++i) f.set_constraint(i, c[i] != 0);
+}
+
+template<typename F>
+void read_constraints(F&, const std::uint8_t*, long) {}
+
+template<typename T>
+std::uint32_t
+triangulation_flags() {
+  return point_flags(typename T::Point()) |
+         constraint_flags(typename T::Face(), 0);
+}
+
+// Files only load into triangulations with the same kind of points and
+// faces.
+template<typename T>
+void
+check_flags(const Triangulation_data_2& d) {
+  if (d.flags != triangulation_flags<T>()) {
+    throw std::runtime_error("file does not match the triangulation's type");
+  }
+}
+
+template<typename T>
+Triangulation_data_2
+triangulation_data(const T& t) {
+  typedef typename T::Triangulation_data_structure Tds;
+  const Tds& tds = t.tds();
+
+  Triangulation_data_2 d;
+  d.dimension = t.dimension();
+  d.flags = triangulation_flags<T>();
+
+  std::unordered_map<typename Tds::Vertex_handle, std::uint64_t,
+                     CGAL::Handle_hash_function> vidx;
+  std::unordered_map<typename Tds::Face_handle, std::uint64_t,
+                     CGAL::Handle_hash_function> fidx;
+  vidx.emplace(t.infinite_vertex(), 0);
+  for (auto v = tds.vertices_begin(); v != tds.vertices_end(); ++v) {
+    if (v != t.infinite_vertex()) vidx.emplace(v, vidx.size());
+  }
+  for (auto f = tds.faces_begin(); f != tds.faces_end(); ++f) {
+    fidx.emplace(f, fidx.size());
+  }
+
+  auto face_index = [&fidx](const typename Tds::Face_handle f) {
+    return f != nullptr ? fidx.at(f) : TRIANGULATION_IO_NONE;
+  };
+  for (auto v = tds.vertices_begin(); v != tds.vertices_end(); ++v) {
+    if (v == t.infinite_vertex()) continue;
+    write_point(v->point(), d);
+    write_hidden(*v, d, 0);
+    d.vertex_faces.push_back(face_index(v->face()));
+  }
+  for (auto f = tds.faces_begin(); f != tds.faces_end(); ++f) {
+    for (int i = 0; i < 3; ++i) {
+      d.face_vertices.push_back(f->vertex(i) != nullptr ? vidx.at(f->vertex(i))
+                                                        : TRIANGULATION_IO_NONE);
+    }
+    for (int i = 0; i < 3; ++i) {
+      d.face_neighbors.push_back(face_index(f->neighbor(i)));
+    }
+    write_constraints(*f, d, 0);
+  }
+  return d;
+}
+
+// Rebuilds the data structure directly, without any insertion, into a new
+// triangulation which only replaces t once it passes the geometric checks
+// too, e.g. the empty circle property of Delaunay triangulations.
+template<typename T>
+void
+restore_triangulation(T& t, const Triangulation_data_2& d) {
+  typedef typename T::Triangulation_data_structure Tds;
+  typedef typename T::Vertex_handle Vertex_handle;
+  typedef typename T::Face_handle   Face_handle;
+
+  check_flags<T>(d);
+  const std::size_t nv = d.number_of_vertices(), nf = d.number_of_faces();
+  if (d.dimension < -1 || d.dimension > 2 ||
+      (d.dimension == -1 ? nv + nf != 0 : nf == 0)) {
+    throw std::runtime_error("invalid triangulation data");
+  }
+
+  T tmp;
+  Tds& tds = tmp.tds();
+  std::vector<Vertex_handle> vhs(1, tmp.infinite_vertex());
+  std::vector<Face_handle> fhs;
+  vhs.reserve(nv + 1);
+  fhs.reserve(nf);
+  for (std::size_t i = 0; i < nv; ++i) vhs.push_back(tds.create_vertex());
+  for (std::size_t i = 0; i < nf; ++i) fhs.push_back(tds.create_face());
+
+  // Entries up to the dimension must be set, the others must not be used.
+  auto vertex = [&](const std::uint64_t i, const int k) {
+    if (i == TRIANGULATION_IO_NONE && k > d.dimension) return Vertex_handle();
+    if (i > nv) throw std::runtime_error("vertex index out of range");
+    return vhs[i];
+  };
+  auto face = [&](const std::uint64_t i, const int k) {
+    if (i == TRIANGULATION_IO_NONE && k > d.dimension) return Face_handle();
+    if (i >= nf) throw std::runtime_error("face index out of range");
+    return fhs[i];
+  };
+  for (std::size_t i = 0; i < nf; ++i) {
+    for (int k = 0; k < 3; ++k) {
+      fhs[i]->set_vertex(k, vertex(d.face_vertices[3 * i + k], k));
+      fhs[i]->set_neighbor(k, face(d.face_neighbors[3 * i + k], k));
+    }
+    if (d.flags & TRIANGULATION_IO_CONSTRAINED) {
+      read_constraints(*fhs[i], &d.constraints[3 * i], 0);
+    }
+  }
+  typename T::Point p;
+  for (std::size_t i = 0; i < nv; ++i) {
+    read_point(&d.coords[d.point_size() * i], p);
+    vhs[i + 1]->set_point(p);
+    vhs[i + 1]->set_face(face(d.vertex_faces[i], 0));
+  }
+  // The infinite vertex points at any face it belongs to.
+  for (std::size_t i = 0; i < nf; ++i) {
+    if (fhs[i]->has_vertex(vhs[0])) {
+      vhs[0]->set_face(fhs[i]);
+      break;
+    }
+  }
+  if (d.dimension >= 0 && vhs[0]->face() == Face_handle()) {
+    throw std::runtime_error("invalid triangulation data");
+  }
+  tds.set_dimension(d.dimension);
+
+  if (!tmp.is_valid()) {
+    throw std::runtime_error("invalid triangulation data");
+  }
+  t.swap(tmp);
+}
+
+// Regular triangulations are rebuilt by inserting the points in index order
+// instead, since they count their hidden vertices privately.  Vertices are
+// never removed meanwhile, so that their indices survive the round trip, and
+// each must end up as hidden as it was saved.
+template<typename Gt, typename Tds>
+void
+restore_triangulation(CGAL::Regular_triangulation_2<Gt, Tds>& t,
+                      const Triangulation_data_2& d) {
+  typedef CGAL::Regular_triangulation_2<Gt, Tds> T;
+
+  check_flags<T>(d);
+  const std::size_t nv = d.number_of_vertices();
+  T tmp;
+  typename T::Face_handle hint;
+  typename T::Point p;
+  for (std::size_t i = 0; i < nv; ++i) {
+    read_point(&d.coords[3 * i], p);
+    const std::size_t n = tmp.number_of_vertices() + tmp.number_of_hidden_vertices();
+    const typename T::Vertex_handle v = tmp.insert(p, hint);
+    if (tmp.number_of_vertices() + tmp.number_of_hidden_vertices() != n + 1) {
+      throw std::runtime_error("invalid triangulation data");
+    }
+    if (!v->is_hidden()) hint = v->face();
+  }
+  std::size_t i = 0;
+  for (auto v = tmp.tds().vertices_begin(); v != tmp.tds().vertices_end(); ++v) {
+    if (v == tmp.infinite_vertex()) continue;
+    if (v->is_hidden() != (d.hidden[i++] != 0)) {
+      throw std::runtime_error("invalid triangulation data");
+    }
+  }
+  t.swap(tmp);
+}
+
+// Hierarchies are rebuilt from the points too, since their upper levels are
+// private; vertices are inserted in index order, hinted with the previous
+// one, and constrained edges restored.  Their indices still survive the
+// round trip.
+template<typename Tr>
+void
+restore_triangulation(CGAL::Triangulation_hierarchy_2<Tr>& t,
+                      const Triangulation_data_2& d) {
+  typedef CGAL::Triangulation_hierarchy_2<Tr> T;
+  typedef typename T::Vertex_handle Vertex_handle;
+
+  check_flags<T>(d);
+  const std::size_t nv = d.number_of_vertices(), nf = d.number_of_faces();
+  T tmp;
+  std::vector<Vertex_handle> vhs(1, tmp.infinite_vertex());
+  vhs.reserve(nv + 1);
+  typename T::Face_handle hint;
+  typename T::Point p;
+  for (std::size_t i = 0; i < nv; ++i) {
+    read_point(&d.coords[2 * i], p);
+    vhs.push_back(tmp.insert(p, hint));
+    hint = vhs.back()->face();
+  }
+  if (tmp.number_of_vertices() != nv) {
+    throw std::runtime_error("invalid triangulation data");
+  }
+
+  if (d.flags & TRIANGULATION_IO_CONSTRAINED) {
+    for (std::size_t i = 0; i < nf; ++i) {
+      for (int k = 0; k < 3; ++k) {
+        if (!d.constraints[3 * i + k]) continue;
+        const std::uint64_t a = d.face_vertices[3 * i + (k + 1) % 3],
+                            b = d.face_vertices[3 * i + (k + 2) % 3];
+        if (a == 0 || b == 0 || a > nv || b > nv || a > b) continue;
+        tmp.insert_constraint(vhs[a], vhs[b]);
+      }
+    }
+  }
+  t.swap(tmp);
+}
+
+template<typename T>
+void
+write_array(std::ofstream& ofs, const std::vector<T>& v) {
+  ofs.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template<typename T>
+void
+read_array(std::ifstream& ifs, std::vector<T>& v, const std::size_t n) {
+  v.resize(n);
+  ifs.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+}
+
+template<typename T>
+void
+write_value(std::ofstream& ofs, const T& x) {
+  ofs.write(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+
+template<typename T>
+T
+read_value(std::ifstream& ifs) {
+  T x;
+  ifs.read(reinterpret_cast<char*>(&x), sizeof(T));
+  return x;
+}
+
+template<typename T>
+void
+save_binary(const T& t, const std::string& filename) {
+  const Triangulation_data_2 d = triangulation_data(t);
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) throw std::runtime_error("cannot open " + filename);
+  ofs.write(TRIANGULATION_IO_MAGIC, sizeof(TRIANGULATION_IO_MAGIC));
+  write_value(ofs, TRIANGULATION_IO_VERSION);
+  write_value(ofs, d.flags);
+  write_value(ofs, d.dimension);
+  write_value(ofs, static_cast<std::uint64_t>(d.number_of_vertices()));
+  write_array(ofs, d.coords);
+  write_array(ofs, d.hidden);
+  write_array(ofs, d.vertex_faces);
+  write_value(ofs, static_cast<std::uint64_t>(d.number_of_faces()));
+  write_array(ofs, d.face_vertices);
+  write_array(ofs, d.face_neighbors);
+  write_array(ofs, d.constraints);
+  if (!ofs) throw std::runtime_error("failed writing " + filename);
+}
+
+// Bounds element counts read from a file by the bytes left in it, before
+// anything gets allocated for them.
+inline void
+check_count(std::ifstream& ifs, const std::uint64_t n,
+            const std::size_t element_size, const std::string& filename) {
+  const std::streampos pos = ifs.tellg();
+  ifs.seekg(0, std::ios::end);
+  const std::streamoff left = ifs.tellg() - pos;
+  ifs.seekg(pos);
+  if (!ifs || left < 0 || n > static_cast<std::uint64_t>(left) / element_size) {
+    throw std::runtime_error("truncated " + filename);
+  }
+}
+
+template<typename T>
+T&
+load_binary(T& t, const std::string& filename) {
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs) throw std::runtime_error("cannot open " + filename);
+  char magic[sizeof(TRIANGULATION_IO_MAGIC)];
+  ifs.read(magic, sizeof(magic));
+  if (!ifs || std::memcmp(magic, TRIANGULATION_IO_MAGIC, sizeof(magic)) != 0) {
+    throw std::runtime_error(filename + " is not a triangulation file");
+  }
+  if (read_value<std::uint32_t>(ifs) != TRIANGULATION_IO_VERSION) {
+    throw std::runtime_error("unsupported version in " + filename);
+  }
+
+  Triangulation_data_2 d;
+  d.flags = read_value<std::uint32_t>(ifs);
+  d.dimension = read_value<std::int32_t>(ifs);
+  const std::uint64_t nv = read_value<std::uint64_t>(ifs);
+  if (!ifs) throw std::runtime_error("failed reading " + filename);
+  check_count(ifs, nv,
+              d.point_size() * sizeof(double) + sizeof(std::uint64_t) +
+              (d.flags & TRIANGULATION_IO_WEIGHTED ? 1 : 0), filename);
+  read_array(ifs, d.coords, d.point_size() * nv);
+  if (d.flags & TRIANGULATION_IO_WEIGHTED) read_array(ifs, d.hidden, nv);
+  read_array(ifs, d.vertex_faces, nv);
+  const std::uint64_t nf = read_value<std::uint64_t>(ifs);
+  if (!ifs) throw std::runtime_error("failed reading " + filename);
+  check_count(ifs, nf,
+              6 * sizeof(std::uint64_t) +
+              (d.flags & TRIANGULATION_IO_CONSTRAINED ? 3 : 0), filename);
+  read_array(ifs, d.face_vertices, 3 * nf);
+  read_array(ifs, d.face_neighbors, 3 * nf);
+  if (d.flags & TRIANGULATION_IO_CONSTRAINED) {
+    read_array(ifs, d.constraints, 3 * nf);
+  }
+  if (!ifs) throw std::runtime_error("failed reading " + filename);
+
+  restore_triangulation(t, d);
+  return t;
+}
+
+} // jlcgal
+
+#endif // CGAL_JL_TRIANGULATION_IO_HPP
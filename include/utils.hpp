@@ -1,6 +1,12 @@
 #ifndef CGAL_JL_UTILS_HPP
 #define CGAL_JL_UTILS_HPP
 
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <CGAL/Handle_hash_function.h>
+
 #include <jlcxx/type_conversion.hpp>
 
 namespace jlcgal {
@@ -26,6 +32,32 @@ collect(InputCirculator begin) {
   return jlarr;
 }
 
+// Triangulation vertices are referred to by their position in the finite
+// vertex iteration order, i.e., the order in which `points` lists them.
+template<typename T>
+std::vector<typename T::Vertex_handle>
+vertex_handles(const T& t) {
+  std::vector<typename T::Vertex_handle> vhs;
+  vhs.reserve(t.number_of_vertices());
+  for (auto it = t.finite_vertices_begin(); it != t.finite_vertices_end(); ++it) {
+    vhs.push_back(it);
+  }
+  return vhs;
+}
+
+template<typename T>
+std::unordered_map<typename T::Vertex_handle, std::size_t, CGAL::Handle_hash_function>
+vertex_indices(const T& t) {
+  std::unordered_map<typename T::Vertex_handle, std::size_t,
+                     CGAL::Handle_hash_function> idx;
+  idx.reserve(t.number_of_vertices());
+  std::size_t i = 0;
+  for (auto it = t.finite_vertices_begin(); it != t.finite_vertices_end(); ++it) {
+    idx.emplace(it, i++);
+  }
+  return idx;
+}
+
 struct Handle_visitor {
   typedef jl_value_t* result_type;
 
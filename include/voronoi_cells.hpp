@@ -0,0 +1,221 @@
+#ifndef CGAL_JL_VORONOI_CELLS_HPP
+#define CGAL_JL_VORONOI_CELLS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include "kernel.hpp"
+#include "parallel.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+typedef std::array<double, 2>     Cell_point_2;
+typedef std::vector<Cell_point_2> Cell_2;
+
+inline Cell_point_2 cell_point(const Point_2& p) {
+  return {{CGAL::to_double(p.x()), CGAL::to_double(p.y())}};
+}
+inline Cell_point_2 cell_point(const Weighted_point_2& p) {
+  return cell_point(p.point());
+}
+
+inline double cell_weight(const Point_2&)            { return 0.; }
+inline double cell_weight(const Weighted_point_2& p) {
+  return CGAL::to_double(p.weight());
+}
+
+// Keeps the part of the convex polygon where n.x <= c (Sutherland-Hodgman),
+// dropping what degenerates to less than a triangle.
+inline void
+clip_cell(Cell_2& poly, const Cell_point_2& n, const double c) {
+  Cell_2 res;
+  res.reserve(poly.size() + 1);
+  for (std::size_t i = 0; i < poly.size(); ++i) {
+    const Cell_point_2& p = poly[i];
+    const Cell_point_2& q = poly[(i + 1) % poly.size()];
+    const double dp = n[0] * p[0] + n[1] * p[1] - c,
+                 dq = n[0] * q[0] + n[1] * q[1] - c;
+    if (dp <= 0) res.push_back(p);
+    if ((dp < 0 && dq > 0) || (dp > 0 && dq < 0)) {
+      const double t = dp / (dp - dq);
+      res.push_back({{p[0] + t * (q[0] - p[0]), p[1] + t * (q[1] - p[1])}});
+    }
+  }
+  if (res.size() < 3) res.clear();
+  poly.swap(res);
+}
+
+// Power (or, for unweighted points, Voronoi) cells of the finite vertices of
+// a Delaunay or regular triangulation, in vertex order, clipped to a
+// rectangle and listed counterclockwise.  Each cell is the rectangle cut by
+// the power bisectors with its neighbors, computed relative to its site to
+// limit cancellation; a cell may end up empty.
+template<typename DG>
+std::vector<Cell_2>
+clipped_cells(const DG& dg, const Iso_rectangle_2& clip) {
+  const std::vector<typename DG::Vertex_handle> vhs = vertex_handles(dg);
+  auto vidx = vertex_indices(dg);
+  std::vector<std::vector<std::size_t>> adj(vhs.size());
+  for (auto it = dg.finite_edges_begin(); it != dg.finite_edges_end(); ++it) {
+    const std::size_t a = vidx[it->first->vertex(DG::ccw(it->second))],
+                      b = vidx[it->first->vertex(DG::cw(it->second))];
+    adj[a].push_back(b);
+    adj[b].push_back(a);
+  }
+
+  const double xmin = CGAL::to_double(clip.xmin()),
+               xmax = CGAL::to_double(clip.xmax()),
+               ymin = CGAL::to_double(clip.ymin()),
+               ymax = CGAL::to_double(clip.ymax());
+  std::vector<Cell_2> cells(vhs.size());
+  parallel_for(vhs.size(), [&](const std::size_t i) {
+    const Cell_point_2 a = cell_point(vhs[i]->point());
+    const double wa = cell_weight(vhs[i]->point());
+    Cell_2& cell = cells[i];
+    cell = {{{xmin - a[0], ymin - a[1]}}, {{xmax - a[0], ymin - a[1]}},
+            {{xmax - a[0], ymax - a[1]}}, {{xmin - a[0], ymax - a[1]}}};
+    for (std::size_t j : adj[i]) {
+      if (cell.empty()) break;
+      const Cell_point_2 b = cell_point(vhs[j]->point());
+      const Cell_point_2 n = {{b[0] - a[0], b[1] - a[1]}};
+      const double wb = cell_weight(vhs[j]->point());
+      clip_cell(cell, {{2 * n[0], 2 * n[1]}},
+                n[0] * n[0] + n[1] * n[1] - wb + wa);
+    }
+    for (Cell_point_2& p : cell) {
+      p[0] += a[0];
+      p[1] += a[1];
+    }
+  });
+  return cells;
+}
+
+// Signed area and centroid of a polygon; the centroid of a degenerate
+// polygon is the average of its vertices.
+inline void
+cell_area_centroid(const Cell_2& poly, double& area, Cell_point_2& centroid) {
+  area = 0;
+  centroid = {{0., 0.}};
+  if (poly.empty()) return;
+
+  const Cell_point_2& o = poly.front();
+  double cx = 0, cy = 0;
+  for (std::size_t i = 1; i + 1 < poly.size(); ++i) {
+    const double ux = poly[i][0] - o[0],     uy = poly[i][1] - o[1],
+                 vx = poly[i + 1][0] - o[0], vy = poly[i + 1][1] - o[1];
+    const double a = (ux * vy - uy * vx) / 2;
+    area += a;
+    cx += a * (ux + vx) / 3;
+    cy += a * (uy + vy) / 3;
+  }
+  if (area != 0) {
+    centroid = {{o[0] + cx / area, o[1] + cy / area}};
+  } else {
+    for (const Cell_point_2& p : poly) {
+      centroid[0] += p[0] / poly.size();
+      centroid[1] += p[1] / poly.size();
+    }
+  }
+}
+
+// Packs the non-empty cells as xy coordinates, with 0-based offsets into
+// the vertices and the 1-based index of the site of each cell.
+inline std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>,
+                  jlcxx::Array<jlcxx::cxxint_t>>
+pack_cells(const std::vector<Cell_2>& cells) {
+  jlcxx::Array<double> coords;
+  jlcxx::Array<jlcxx::cxxint_t> offsets, sites;
+  jlcxx::cxxint_t n = 0;
+  offsets.push_back(0);
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    if (cells[i].empty()) continue;
+    for (const Cell_point_2& p : cells[i]) {
+      coords.push_back(p[0]);
+      coords.push_back(p[1]);
+    }
+    n += cells[i].size();
+    offsets.push_back(n);
+    sites.push_back(i + 1);
+  }
+  return std::make_tuple(coords, offsets, sites);
+}
+
+// Accumulates polylines, clipped to a rectangle, as packed xy coordinates
+// and CSR offsets counting points.  Consecutive pieces that meet are joined.
+class Polyline_clipper_2 {
+public:
+  Polyline_clipper_2(const Iso_rectangle_2& clip)
+    : _xmin(CGAL::to_double(clip.xmin())), _xmax(CGAL::to_double(clip.xmax())),
+      _ymin(CGAL::to_double(clip.ymin())), _ymax(CGAL::to_double(clip.ymax())) {
+    _offsets.push_back(0);
+  }
+
+  // Adds p + t(q - p) for t in [t0, t1], where either bound may be infinite.
+  void add(const double px, const double py, const double qx, const double qy,
+           double t0 = 0, double t1 = 1) {
+    const double dx = qx - px, dy = qy - py;
+    if (!clip_axis(-dx, px - _xmin, t0, t1) ||
+        !clip_axis( dx, _xmax - px, t0, t1) ||
+        !clip_axis(-dy, py - _ymin, t0, t1) ||
+        !clip_axis( dy, _ymax - py, t0, t1)) {
+      close();
+      return;
+    }
+    const double x0 = px + t0 * dx, y0 = py + t0 * dy,
+                 x1 = px + t1 * dx, y1 = py + t1 * dy;
+    const std::size_t n = _coords.size();
+    if (_open && (_coords[n - 2] != x0 || _coords[n - 1] != y0)) close();
+    if (!_open) {
+      _coords.push_back(x0);
+      _coords.push_back(y0);
+      _open = true;
+    }
+    _coords.push_back(x1);
+    _coords.push_back(y1);
+  }
+
+  void close() {
+    if (!_open) return;
+    _offsets.push_back(_coords.size() / 2);
+    _open = false;
+  }
+
+  std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>> result() {
+    close();
+    return std::make_tuple(collect(_coords.begin(), _coords.end()),
+                           collect(_offsets.begin(), _offsets.end()));
+  }
+
+private:
+  // Liang-Barsky: restricts [t0, t1] to where den * t <= num, returning
+  // whether anything is left.
+  static bool clip_axis(const double den, const double num, double& t0,
+                        double& t1) {
+    if (den == 0) return num >= 0;
+    const double t = num / den;
+    if (den > 0) {
+      if (t < t0) return false;
+      t1 = std::min(t1, t);
+    } else {
+      if (t > t1) return false;
+      t0 = std::max(t0, t);
+    }
+    return t0 <= t1;
+  }
+
+  double _xmin, _xmax, _ymin, _ymax;
+  bool _open = false;
+  std::vector<double> _coords;
+  std::vector<jlcxx::cxxint_t> _offsets;
+};
+
+} // jlcgal
+
+#endif // CGAL_JL_VORONOI_CELLS_HPP
@@ -0,0 +1,176 @@
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <CGAL/Alpha_shape_2.h>
+#include <CGAL/Alpha_shape_face_base_2.h>
+#include <CGAL/Alpha_shape_vertex_base_2.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include "parallel.hpp"
+#include "triangulation.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+typedef CGAL::Alpha_shape_vertex_base_2<Kernel>                    As_vb_2;
+typedef CGAL::Alpha_shape_face_base_2<Kernel>                      As_fb_2;
+typedef CGAL::Triangulation_data_structure_2<As_vb_2, As_fb_2>     As_tds_2;
+typedef CGAL::Alpha_shape_2<
+  CGAL::Delaunay_triangulation_2<Kernel, As_tds_2>>                Alpha_shape_2;
+
+typedef CGAL::Alpha_shape_vertex_base_2<Kernel
+  , CGAL::Regular_triangulation_vertex_base_2<Kernel>>             Was_vb_2;
+typedef CGAL::Alpha_shape_face_base_2<Kernel
+  , CGAL::Regular_triangulation_face_base_2<Kernel>>               Was_fb_2;
+typedef CGAL::Triangulation_data_structure_2<Was_vb_2, Was_fb_2>   Was_tds_2;
+typedef CGAL::Alpha_shape_2<
+  CGAL::Regular_triangulation_2<Kernel, Was_tds_2>>                Weighted_alpha_shape_2;
+
+template<typename AS>
+typename AS::Mode
+alpha_mode(const bool regularized) {
+  return regularized ? AS::REGULARIZED : AS::GENERAL;
+}
+
+// Appends the boundary of the alpha shape as x1, y1, x2, y2 quadruples.
+template<typename AS>
+void
+boundary_segments(const AS& as, std::vector<double>& out) {
+  for (auto it = as.alpha_shape_edges_begin();
+       it != as.alpha_shape_edges_end(); ++it) {
+    const typename AS::Face_handle f = it->first;
+    const Point_2& p = bare_point(f->vertex(AS::ccw(it->second))->point());
+    const Point_2& q = bare_point(f->vertex(AS::cw(it->second))->point());
+    out.push_back(CGAL::to_double(p.x()));
+    out.push_back(CGAL::to_double(p.y()));
+    out.push_back(CGAL::to_double(q.x()));
+    out.push_back(CGAL::to_double(q.y()));
+  }
+}
+
+// Computes one alpha shape per cluster, where the points of the i-th cluster
+// are `xy[2*offsets[i]+1:2*offsets[i+1]]`.  Returns the boundary segments of
+// every cluster, the ones of the i-th cluster being the quadruples
+// `offsets[i]+1:offsets[i+1]` of the packed coordinates.
+std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>>
+alpha_shape_segments(jlcxx::ArrayRef<double> xy,
+                     jlcxx::ArrayRef<jlcxx::cxxint_t> offsets,
+                     const double alpha,
+                     const bool regularized) {
+  if (xy.size() % 2 != 0) {
+    throw std::invalid_argument("coordinates must come in xy pairs");
+  }
+  if (offsets.size() == 0 || offsets[0] != 0) {
+    throw std::invalid_argument("offsets must start at 0");
+  }
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      throw std::invalid_argument("offsets must be non-decreasing");
+    }
+  }
+  if (static_cast<std::size_t>(2 * offsets[offsets.size() - 1]) != xy.size()) {
+    throw std::invalid_argument("offsets do not match coordinates");
+  }
+
+  const std::size_t n = offsets.size() - 1;
+  std::vector<std::vector<double>> segs(n);
+  parallel_for(n, [&](const std::size_t i) {
+    std::vector<Point_2> ps;
+    ps.reserve(offsets[i + 1] - offsets[i]);
+    for (jlcxx::cxxint_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+      ps.emplace_back(xy[2 * j], xy[2 * j + 1]);
+    }
+    Alpha_shape_2 as(ps.begin(), ps.end(), FT(alpha),
+                     alpha_mode<Alpha_shape_2>(regularized));
+    boundary_segments(as, segs[i]);
+  });
+
+  std::vector<double> coords;
+  std::vector<jlcxx::cxxint_t> segoffsets(1, 0);
+  for (const auto& s : segs) {
+    coords.insert(coords.end(), s.begin(), s.end());
+    segoffsets.push_back(coords.size() / 4);
+  }
+
+  return std::make_tuple(collect(coords.begin(), coords.end()),
+                         collect(segoffsets.begin(), segoffsets.end()));
+}
+
+template<typename AS, typename Tr>
+void
+wrap_alpha_shape(jlcxx::Module& cgal, const std::string& name) {
+  typedef typename AS::Point Point;
+
+  cgal.add_type<AS>(name)
+    // Creation
+    .method(name, [](jlcxx::ArrayRef<Point> ps, const FT& alpha,
+                     const bool regularized) {
+      return jlcxx::create<AS>(ps.begin(), ps.end(), alpha,
+                               alpha_mode<AS>(regularized));
+    })
+    .method(name, [](const Tr& t, const FT& alpha, const bool regularized) {
+      return jlcxx::create<AS>(t.points_begin(), t.points_end(), alpha,
+                               alpha_mode<AS>(regularized));
+    })
+    // Modifiers
+    .method("set_alpha!", [](AS& as, const FT& alpha) -> AS& {
+      as.set_alpha(alpha);
+      return as;
+    })
+    .method("set_mode!", [](AS& as, const bool regularized) -> AS& {
+      as.set_mode(alpha_mode<AS>(regularized));
+      return as;
+    })
+    // Access Functions
+    .method("get_alpha", [](const AS& as) { return as.get_alpha(); })
+    .method("number_of_alphas", &AS::number_of_alphas)
+    .method("number_of_solid_components", [](const AS& as) {
+      return as.number_of_solid_components();
+    })
+    .method("optimal_alpha", [](const AS& as, const jlcxx::cxxint_t n) {
+      auto it = as.find_optimal_alpha(n);
+      if (it == as.alpha_end()) {
+        throw std::runtime_error("no alpha yields that many components");
+      }
+      return *it;
+    })
+    // Classification, with codes following CGAL's Classification_type:
+    // 0 for EXTERIOR, 1 for SINGULAR, 2 for REGULAR and 3 for INTERIOR.
+    .method("classify", [](const AS& as, const Point& p) {
+      return static_cast<jlcxx::cxxint_t>(as.classify(p));
+    })
+    .method("classify_faces", [](const AS& as) {
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (auto it = as.finite_faces_begin(); it != as.finite_faces_end(); ++it) {
+        jlarr.push_back(static_cast<jlcxx::cxxint_t>(as.classify(it)));
+      }
+      return jlarr;
+    })
+    .method("classify_edges", [](const AS& as) {
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (auto it = as.finite_edges_begin(); it != as.finite_edges_end(); ++it) {
+        jlarr.push_back(static_cast<jlcxx::cxxint_t>(as.classify(*it)));
+      }
+      return jlarr;
+    })
+    // Flat Export
+    .method("boundary_segments", [](const AS& as) {
+      std::vector<double> segs;
+      boundary_segments(as, segs);
+      return collect(segs.begin(), segs.end());
+    })
+    ;
+}
+
+void wrap_alpha_shape_2(jlcxx::Module& cgal) {
+  wrap_alpha_shape<Alpha_shape_2, DTr_2>(cgal, "AlphaShape2");
+  wrap_alpha_shape<Weighted_alpha_shape_2, RTr_2>(cgal, "WeightedAlphaShape2");
+
+  cgal.method("alpha_shape_segments", &alpha_shape_segments);
+}
+
+} // jlcgal
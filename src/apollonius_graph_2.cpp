@@ -0,0 +1,128 @@
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include <julia.h>
+
+#include "apollonius_graph.hpp"
+#include "parallel.hpp"
+#include "utils.hpp"
+#include "voronoi_cells.hpp"
+
+namespace jlcgal {
+
+template<typename AG>
+void
+wrap_apollonius_graph(jlcxx::Module& cgal, const std::string& name) {
+  typedef typename AG::Edge   Edge;
+  typedef typename AG::Face   Face;
+  typedef typename AG::Vertex Vertex;
+  typedef Apollonius_site_2   Site_2;
+
+  auto ag = cgal.add_type<AG>(name);
+  cgal.add_type<Edge>(name + "Edge");
+  auto agface   = cgal.add_type<Face>  (name + "Face");
+  auto agvertex = cgal.add_type<Vertex>(name + "Vertex");
+
+  agvertex
+    .method("site", [](const Vertex& v) { return v.site(); })
+    ;
+
+  agface
+    .method("vertex", [](const Face& f, const jlcxx::cxxint_t i) {
+      return *f.vertex(i - 1);
+    })
+    .method("neighbor", [](const Face& f, const jlcxx::cxxint_t i) {
+      return *f.neighbor(i - 1);
+    })
+    ;
+
+  ag
+    // Creation
+    .template constructor<const AG&>()
+    .method(name, [](jlcxx::ArrayRef<Site_2> ss) {
+      return jlcxx::create<AG>(ss.begin(), ss.end());
+    })
+    // Access Functions
+    .method("dimension",               &AG::dimension)
+    .method("number_of_vertices",      &AG::number_of_vertices)
+    .method("number_of_faces",         &AG::number_of_faces)
+    .method("number_of_visible_sites", &AG::number_of_visible_sites)
+    .method("number_of_hidden_sites",  &AG::number_of_hidden_sites)
+    .method("sites", [](const AG& ag) {
+      return collect(ag.visible_sites_begin(), ag.visible_sites_end());
+    })
+    .method("vertices", [](const AG& ag) {
+      return collect(ag.finite_vertices_begin(), ag.finite_vertices_end());
+    })
+    // Queries
+    .method("nearest_neighbor", [](const AG& ag, const Point_2& p) {
+      auto v = ag.nearest_neighbor(p);
+      return v != nullptr ?
+        (jl_value_t*)jlcxx::box<Site_2>(v->site()) :
+        jl_nothing;
+    })
+    // Batched over packed xy coordinates, returning 1-based indices into
+    // `sites` (0 if there are none), each walk starting from the previous
+    // answer.
+    .method("nearest_neighbor", [](const AG& ag, jlcxx::ArrayRef<double> xy) {
+      auto vidx = vertex_indices(ag);
+      std::vector<jlcxx::cxxint_t> res(xy.size() / 2, 0);
+      parallel_for_ranges(res.size(), [&](const std::size_t b, const std::size_t e) {
+        typename AG::Vertex_handle hint;
+        for (std::size_t i = b; i < e; ++i) {
+          const Point_2 p(xy[2 * i], xy[2 * i + 1]);
+          hint = hint != nullptr ? ag.nearest_neighbor(p, hint)
+                                 : ag.nearest_neighbor(p);
+          if (hint != nullptr) res[i] = vidx.at(hint) + 1;
+        }
+      });
+      return collect(res.begin(), res.end());
+    })
+    // Flat Export, of the Voronoi edges clipped to a rectangle, as polylines
+    // with CSR offsets counting points; hyperbolic arcs are sampled until
+    // within `tolerance` of the curve.
+    .method("bisectors", [](const AG& ag, const Iso_rectangle_2& clip,
+                            const double tolerance) {
+      return Apollonius_diagram_tracer_2<AG>(ag, clip, tolerance).bisectors();
+    })
+    // Validity Check
+    .method("is_valid", [](const AG& ag) { return ag.is_valid(); })
+    ;
+  cgal.set_override_module(jl_base_module);
+  ag
+    // Insertion and Removal
+    .method("insert!", [](AG& ag, jlcxx::ArrayRef<Site_2> ss) -> AG& {
+      ag.insert(ss.begin(), ss.end());
+      return ag;
+    })
+    .method("push!", [](AG& ag, const Site_2& s) -> AG& {
+      ag.insert(s);
+      return ag;
+    })
+    .method("empty!", [](AG& ag) -> AG& {
+      ag.clear();
+      return ag;
+    })
+    ;
+  cgal.unset_override_module();
+}
+
+void wrap_apollonius_graph_2(jlcxx::Module& cgal) {
+  typedef Apollonius_site_2 Site_2;
+
+  cgal.add_type<Site_2>("ApolloniusSite2")
+    .constructor<const Point_2&, const FT&>()
+    .method("point",  [](const Site_2& s) { return s.point();  })
+    .method("weight", [](const Site_2& s) { return s.weight(); })
+    ;
+
+  wrap_apollonius_graph<AG_2> (cgal, "ApolloniusGraph2");
+  wrap_apollonius_graph<AGH_2>(cgal, "ApolloniusGraphHierarchy2");
+}
+
+} // jlcgal
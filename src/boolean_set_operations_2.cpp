@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <CGAL/Boolean_set_operations_2.h>
+#include <CGAL/Polygon_set_2.h>
+#ifndef JLCGAL_EXACT_CONSTRUCTIONS
+#include <CGAL/Cartesian_converter.h>
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#endif
+
+#include <jlcxx/module.hpp>
+
+#include "parallel.hpp"
+#include "polygon_2.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+// Arrangement-based operations need exact constructions: intersection
+// points rounded to doubles may corrupt the arrangement.  With the inexact
+// kernel, polygons are converted to the exact one and results rounded back.
+#ifdef JLCGAL_EXACT_CONSTRUCTIONS
+typedef Kernel Bso_kernel;
+struct To_bso {
+  const Point_2& operator()(const Point_2& p) const { return p; }
+};
+typedef To_bso From_bso;
+#else
+typedef CGAL::Exact_predicates_exact_constructions_kernel Bso_kernel;
+typedef CGAL::Cartesian_converter<Kernel, Bso_kernel>     To_bso;
+typedef CGAL::Cartesian_converter<Bso_kernel, Kernel>     From_bso;
+#endif
+
+typedef CGAL::Polygon_2<Bso_kernel>            Bso_polygon_2;
+typedef CGAL::Polygon_with_holes_2<Bso_kernel> Bso_polygon_with_holes_2;
+typedef CGAL::Polygon_set_2<Bso_kernel>        Bso_polygon_set_2;
+
+template<typename K2, typename K1, typename Converter>
+CGAL::Polygon_2<K2>
+convert_polygon(const CGAL::Polygon_2<K1>& p, const Converter& c) {
+  CGAL::Polygon_2<K2> res;
+  for (auto v = p.vertices_begin(); v != p.vertices_end(); ++v) {
+    res.push_back(c(*v));
+  }
+  return res;
+}
+
+template<typename K2, typename K1, typename Converter>
+CGAL::Polygon_with_holes_2<K2>
+convert_polygon(const CGAL::Polygon_with_holes_2<K1>& pwh, const Converter& c) {
+  CGAL::Polygon_with_holes_2<K2> res(convert_polygon<K2>(pwh.outer_boundary(), c));
+  for (auto h = pwh.holes_begin(); h != pwh.holes_end(); ++h) {
+    res.add_hole(convert_polygon<K2>(*h, c));
+  }
+  return res;
+}
+
+// Boolean set operations expect counterclockwise outer boundaries and
+// clockwise holes, whereas polygons may come in either orientation.
+inline Bso_polygon_2
+oriented(const Polygon_2& p, const CGAL::Orientation o = CGAL::COUNTERCLOCKWISE) {
+  Bso_polygon_2 res = convert_polygon<Bso_kernel>(p, To_bso());
+  if (res.size() > 2 && res.orientation() != o) res.reverse_orientation();
+  return res;
+}
+
+inline Bso_polygon_with_holes_2
+oriented(const Polygon_with_holes_2& pwh) {
+  Bso_polygon_with_holes_2 res(oriented(pwh.outer_boundary()));
+  for (auto h = pwh.holes_begin(); h != pwh.holes_end(); ++h) {
+    res.add_hole(oriented(*h, CGAL::CLOCKWISE));
+  }
+  return res;
+}
+
+template<typename InputIterator>
+jlcxx::Array<Polygon_with_holes_2>
+collect_polygons(InputIterator first, InputIterator beyond) {
+  jlcxx::Array<Polygon_with_holes_2> jlarr;
+  for (; first != beyond; ++first) {
+    jlarr.push_back(convert_polygon<Kernel>(*first, From_bso()));
+  }
+  return jlarr;
+}
+
+// Results are arrays of polygons with holes, as unions and differences may
+// be disconnected.
+template<typename P1, typename P2>
+jlcxx::Array<Polygon_with_holes_2>
+join(const P1& p1, const P2& p2) {
+  std::vector<Bso_polygon_with_holes_2> res(1);
+  if (!CGAL::join(oriented(p1), oriented(p2), res.front())) {
+    res = {Bso_polygon_with_holes_2(oriented(p1)),
+           Bso_polygon_with_holes_2(oriented(p2))};
+  }
+  return collect_polygons(res.begin(), res.end());
+}
+
+#define BOOLEAN_SET_OPERATION(OP) \
+template<typename P1, typename P2> \
+jlcxx::Array<Polygon_with_holes_2> \
+OP(const P1& p1, const P2& p2) { \
+  std::vector<Bso_polygon_with_holes_2> res; \
+  CGAL::OP(oriented(p1), oriented(p2), std::back_inserter(res)); \
+  return collect_polygons(res.begin(), res.end()); \
+}
+
+BOOLEAN_SET_OPERATION(intersection)
+BOOLEAN_SET_OPERATION(difference)
+BOOLEAN_SET_OPERATION(symmetric_difference)
+
+#undef BOOLEAN_SET_OPERATION
+
+template<typename P1, typename P2>
+bool
+do_intersect(const P1& p1, const P2& p2) {
+  return CGAL::do_intersect(oriented(p1), oriented(p2));
+}
+
+// Empty polygons (as from a collection) have no area, whereas polygons with
+// holes with an empty outer boundary stand for the whole plane.
+inline bool is_empty_polygon(const Polygon_2& p) { return p.is_empty(); }
+inline bool is_empty_polygon(const Polygon_with_holes_2& pwh) {
+  return pwh.outer_boundary().is_empty();
+}
+
+// Number of polygons joined by a single polygon set before sets get merged
+// pairwise, in parallel.
+const std::size_t UNION_ALL_CHUNK_SIZE = 1024;
+
+// Union of all polygons: chunks are joined independently (each one with the
+// polygon set's own divide-and-conquer sweep), then merged pairwise until a
+// single set remains.  Exact polygons are only built within the task that
+// uses them, since lazy exact numbers must not be shared between threads.
+template<typename P>
+jlcxx::Array<Polygon_with_holes_2>
+union_all(const std::vector<P>& ps) {
+  const std::size_t nchunks =
+    (ps.size() + UNION_ALL_CHUNK_SIZE - 1) / UNION_ALL_CHUNK_SIZE;
+  std::vector<Bso_polygon_set_2> sets(nchunks);
+  parallel_for(nchunks, [&](const std::size_t i) {
+    const std::size_t b = i * UNION_ALL_CHUNK_SIZE,
+                      e = std::min(ps.size(), b + UNION_ALL_CHUNK_SIZE);
+    std::vector<Bso_polygon_with_holes_2> chunk;
+    chunk.reserve(e - b);
+    for (std::size_t k = b; k < e; ++k) {
+      if (is_empty_polygon(ps[k])) continue;
+      chunk.push_back(Bso_polygon_with_holes_2(oriented(ps[k])));
+    }
+    sets[i].join(chunk.begin(), chunk.end());
+  });
+
+  while (sets.size() > 1) {
+    const std::size_t half = sets.size() / 2;
+    parallel_for(half, [&](const std::size_t i) {
+      sets[i].join(sets[sets.size() - 1 - i]);
+    });
+    sets.resize(sets.size() - half);
+  }
+
+  std::vector<Bso_polygon_with_holes_2> res;
+  if (!sets.empty()) sets.front().polygons_with_holes(std::back_inserter(res));
+  return collect_polygons(res.begin(), res.end());
+}
+
+template<typename P1, typename P2>
+void
+wrap_boolean_set_operations(jlcxx::Module& cgal) {
+  cgal.method("join",                 &join<P1, P2>);
+  cgal.method("intersection",         &intersection<P1, P2>);
+  cgal.method("difference",           &difference<P1, P2>);
+  cgal.method("symmetric_difference", &symmetric_difference<P1, P2>);
+  cgal.method("do_intersect",         &do_intersect<P1, P2>);
+}
+
+void wrap_boolean_set_operations_2(jlcxx::Module& cgal) {
+  wrap_boolean_set_operations<Polygon_2,            Polygon_2>           (cgal);
+  wrap_boolean_set_operations<Polygon_2,            Polygon_with_holes_2>(cgal);
+  wrap_boolean_set_operations<Polygon_with_holes_2, Polygon_2>           (cgal);
+  wrap_boolean_set_operations<Polygon_with_holes_2, Polygon_with_holes_2>(cgal);
+
+  cgal.method("union_all", [](jlcxx::ArrayRef<Polygon_2> ps) {
+    return union_all(std::vector<Polygon_2>(ps.begin(), ps.end()));
+  });
+  cgal.method("union_all", [](jlcxx::ArrayRef<Polygon_with_holes_2> ps) {
+    return union_all(std::vector<Polygon_with_holes_2>(ps.begin(), ps.end()));
+  });
+  cgal.method("union_all", [](const Polygon_collection_2& pc) {
+    return union_all<Polygon_with_holes_2>(pc);
+  });
+}
+
+} // jlcgal
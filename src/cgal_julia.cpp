@@ -9,7 +9,22 @@ namespace jlcgal {
   void wrap_polygon_2(jlcxx::Module&);
   void wrap_straight_skeleton_2(jlcxx::Module&);
   void wrap_triangulation_2(jlcxx::Module&);
+  void wrap_triangulation_3(jlcxx::Module&);
+  void wrap_apollonius_graph_2(jlcxx::Module&);
   void wrap_voronoi_diagram_2(jlcxx::Module&);
+  void wrap_alpha_shape_2(jlcxx::Module&);
+  void wrap_interpolation_2(jlcxx::Module&);
+  void wrap_frozen_triangulation_2(jlcxx::Module&);
+  void wrap_periodic_2_triangulation_2(jlcxx::Module&);
+  void wrap_tiled_delaunay_2(jlcxx::Module&);
+  void wrap_streaming_delaunay_2(jlcxx::Module&);
+  void wrap_lloyd_relaxation_2(jlcxx::Module&);
+  void wrap_segment_delaunay_graph_2(jlcxx::Module&);
+  void wrap_boolean_set_operations_2(jlcxx::Module&);
+  void wrap_polygon_index_2(jlcxx::Module&);
+  void wrap_polygon_triangulation_2(jlcxx::Module&);
+  void wrap_partition_2(jlcxx::Module&);
+  void wrap_polyline_simplification_2(jlcxx::Module&);
 } // jlcgal
 
 JLCXX_MODULE define_julia_module(jlcxx::Module& cgal) {
@@ -22,5 +37,20 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& cgal) {
   wrap_polygon_2(cgal);
   wrap_straight_skeleton_2(cgal);
   wrap_triangulation_2(cgal);
+  wrap_triangulation_3(cgal);
+  wrap_apollonius_graph_2(cgal);
+  wrap_segment_delaunay_graph_2(cgal);
   wrap_voronoi_diagram_2(cgal);
+  wrap_alpha_shape_2(cgal);
+  wrap_interpolation_2(cgal);
+  wrap_frozen_triangulation_2(cgal);
+  wrap_periodic_2_triangulation_2(cgal);
+  wrap_tiled_delaunay_2(cgal);
+  wrap_streaming_delaunay_2(cgal);
+  wrap_lloyd_relaxation_2(cgal);
+  wrap_boolean_set_operations_2(cgal);
+  wrap_polygon_index_2(cgal);
+  wrap_polygon_triangulation_2(cgal);
+  wrap_partition_2(cgal);
+  wrap_polyline_simplification_2(cgal);
 }
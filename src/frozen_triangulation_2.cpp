@@ -0,0 +1,218 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <jlcxx/module.hpp>
+
+#include "parallel.hpp"
+#include "triangulation.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+// Immutable, compact snapshot of a 2D triangulation's finite part: vertex
+// points plus face-to-vertex, face-to-neighbor and vertex adjacency arrays.
+// Being read-only, a single snapshot can be shared by any number of
+// concurrent readers while the original triangulation keeps changing.
+// Indices are 0-based internally, -1 standing for "none".  Regular
+// triangulations keep their bare points only, leaving hidden vertices out.
+class Frozen_triangulation_2 {
+public:
+  template<typename T>
+  Frozen_triangulation_2(const T& t, const bool is_delaunay)
+    : _is_delaunay(is_delaunay) {
+    auto vidx = vertex_indices(t);
+    _points.reserve(t.number_of_vertices());
+    for (auto it = t.finite_vertices_begin(); it != t.finite_vertices_end(); ++it) {
+      _points.push_back(bare_point(it->point()));
+    }
+
+    std::unordered_map<typename T::Face_handle, int,
+                       CGAL::Handle_hash_function> fidx;
+    int nf = 0;
+    for (auto it = t.finite_faces_begin(); it != t.finite_faces_end(); ++it) {
+      fidx.emplace(it, nf++);
+    }
+    _faces.reserve(3 * nf);
+    _neighbors.reserve(3 * nf);
+    for (auto it = t.finite_faces_begin(); it != t.finite_faces_end(); ++it) {
+      for (int i = 0; i < 3; ++i) {
+        _faces.push_back(vidx[it->vertex(i)]);
+        auto n = fidx.find(it->neighbor(i));
+        _neighbors.push_back(n != fidx.end() ? n->second : -1);
+      }
+    }
+
+    std::vector<std::vector<int>> adj(_points.size());
+    for (auto it = t.finite_edges_begin(); it != t.finite_edges_end(); ++it) {
+      const int a = vidx[it->first->vertex(T::ccw(it->second))],
+                b = vidx[it->first->vertex(T::cw(it->second))];
+      adj[a].push_back(b);
+      adj[b].push_back(a);
+    }
+    _adjacency_offsets.push_back(0);
+    for (const auto& vs : adj) {
+      _adjacency.insert(_adjacency.end(), vs.begin(), vs.end());
+      _adjacency_offsets.push_back(_adjacency.size());
+    }
+  }
+
+  std::size_t number_of_vertices() const { return _points.size(); }
+  std::size_t number_of_faces()    const { return _faces.size() / 3; }
+
+  const std::vector<Point_2>& points()    const { return _points; }
+  const std::vector<int>&     faces()     const { return _faces; }
+  const std::vector<int>&     neighbors() const { return _neighbors; }
+
+  // Visibility walk from face `hint`, returning the face containing p or -1
+  // if p lies outside the convex hull.  `last` gets the last face visited.
+  int locate(const Point_2& p, int hint, int& last) const {
+    last = -1;
+    if (_faces.empty()) return -1;
+
+    int f = hint >= 0 ? hint : 0;
+    // xorshift, randomizing which edge gets tested first so that walks also
+    // terminate on non-Delaunay triangulations
+    std::uint32_t rng = 2463534242u ^ static_cast<std::uint32_t>(f);
+    for (;;) {
+      last = f;
+      rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+      const int start = rng % 3;
+      bool moved = false;
+      for (int k = 0; k < 3 && !moved; ++k) {
+        const int i = (start + k) % 3;
+        const Point_2& a = _points[_faces[3 * f + (i + 1) % 3]];
+        const Point_2& b = _points[_faces[3 * f + (i + 2) % 3]];
+        if (CGAL::orientation(a, b, p) == CGAL::RIGHT_TURN) {
+          f = _neighbors[3 * f + i];
+          if (f < 0) return -1;
+          moved = true;
+        }
+      }
+      if (!moved) return f;
+    }
+  }
+
+  // Greedy walk along the adjacency graph, which reaches the nearest vertex
+  // on Delaunay triangulations; other triangulations fall back to a scan.
+  int nearest_vertex(const Point_2& p, int hint, int& last) const {
+    if (_points.empty()) return -1;
+
+    if (!_is_delaunay) {
+      int v = 0;
+      for (int u = 1; u < static_cast<int>(_points.size()); ++u) {
+        if (CGAL::compare_distance_to_point(p, _points[u], _points[v])
+            == CGAL::SMALLER) v = u;
+      }
+      return v;
+    }
+
+    int v = 0;
+    if (!_faces.empty()) {
+      locate(p, hint, last);
+      v = _faces[3 * last];
+      for (int i = 1; i < 3; ++i) {
+        const int u = _faces[3 * last + i];
+        if (CGAL::compare_distance_to_point(p, _points[u], _points[v])
+            == CGAL::SMALLER) v = u;
+      }
+    }
+    for (bool moved = true; moved; ) {
+      moved = false;
+      for (int k = _adjacency_offsets[v]; k < _adjacency_offsets[v + 1]; ++k) {
+        const int u = _adjacency[k];
+        if (CGAL::compare_distance_to_point(p, _points[u], _points[v])
+            == CGAL::SMALLER) {
+          v = u;
+          moved = true;
+          break;
+        }
+      }
+    }
+    return v;
+  }
+
+private:
+  bool _is_delaunay;
+  std::vector<Point_2> _points;
+  std::vector<int> _faces;
+  std::vector<int> _neighbors;
+  std::vector<int> _adjacency_offsets;
+  std::vector<int> _adjacency;
+};
+
+// Runs a hinted query (locate or nearest_vertex) over packed xy coordinates,
+// returning 1-based indices, 0 standing for "none".
+template<typename Query>
+jlcxx::Array<jlcxx::cxxint_t>
+batch_query(jlcxx::ArrayRef<double> xy, const Query& query) {
+  std::vector<jlcxx::cxxint_t> res(xy.size() / 2);
+  parallel_for_ranges(res.size(), [&](const std::size_t b, const std::size_t e) {
+    int hint = -1;
+    for (std::size_t i = b; i < e; ++i) {
+      res[i] = query(Point_2(xy[2 * i], xy[2 * i + 1]), hint) + 1;
+    }
+  });
+  return collect(res.begin(), res.end());
+}
+
+template<typename T>
+void
+wrap_freeze(jlcxx::Module& cgal, const bool is_delaunay) {
+  cgal.method("freeze", [is_delaunay](const T& t) {
+    return jlcxx::create<Frozen_triangulation_2>(t, is_delaunay);
+  });
+}
+
+void wrap_frozen_triangulation_2(jlcxx::Module& cgal) {
+  typedef Frozen_triangulation_2 FTr_2;
+
+  cgal.add_type<FTr_2>("FrozenTriangulation2")
+    // Access Functions
+    .method("number_of_vertices", &FTr_2::number_of_vertices)
+    .method("number_of_faces",    &FTr_2::number_of_faces)
+    .method("points", [](const FTr_2& ft) {
+      return collect(ft.points().begin(), ft.points().end());
+    })
+    // Flat Export, with 1-based indices and 0 for missing neighbors
+    .method("face_vertices", [](const FTr_2& ft) {
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (int v : ft.faces()) jlarr.push_back(v + 1);
+      return jlarr;
+    })
+    .method("face_neighbors", [](const FTr_2& ft) {
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (int f : ft.neighbors()) jlarr.push_back(f + 1);
+      return jlarr;
+    })
+    // Queries
+    .method("locate", [](const FTr_2& ft, const Point_2& p) {
+      int last;
+      return static_cast<jlcxx::cxxint_t>(ft.locate(p, -1, last) + 1);
+    })
+    .method("locate", [](const FTr_2& ft, jlcxx::ArrayRef<double> xy) {
+      return batch_query(xy, [&ft](const Point_2& p, int& hint) {
+        return ft.locate(p, hint, hint);
+      });
+    })
+    .method("nearest_vertex", [](const FTr_2& ft, const Point_2& p) {
+      int last;
+      return static_cast<jlcxx::cxxint_t>(ft.nearest_vertex(p, -1, last) + 1);
+    })
+    .method("nearest_vertex", [](const FTr_2& ft, jlcxx::ArrayRef<double> xy) {
+      return batch_query(xy, [&ft](const Point_2& p, int& hint) {
+        return ft.nearest_vertex(p, hint, hint);
+      });
+    })
+    ;
+
+  wrap_freeze<Tr_2>   (cgal, false);
+  wrap_freeze<DTr_2>  (cgal, true);
+  wrap_freeze<CTr_2>  (cgal, false);
+  // nearest neighbors in power distance differ from Euclidean ones
+  wrap_freeze<RTr_2>  (cgal, false);
+  wrap_freeze<DHTr_2> (cgal, true);
+  wrap_freeze<CDHTr_2>(cgal, false);
+}
+
+} // jlcgal
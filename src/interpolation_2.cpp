@@ -0,0 +1,197 @@
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <CGAL/Interpolation_gradient_fitting_traits_2.h>
+#include <CGAL/function_objects.h>
+#include <CGAL/interpolation_functions.h>
+#include <CGAL/natural_neighbor_coordinates_2.h>
+#include <CGAL/sibson_gradient_fitting.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include "parallel.hpp"
+#include "triangulation.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+typedef CGAL::Interpolation_gradient_fitting_traits_2<Kernel> Gradient_traits_2;
+
+typedef std::pair<DTr_2::Vertex_handle, FT> Coordinate_2;
+typedef std::unordered_map<DTr_2::Vertex_handle, std::size_t,
+                           CGAL::Handle_hash_function> Vertex_index_map;
+
+// Values (and gradients) are given by arrays aligned with the vertex order.
+struct Vertex_value {
+  typedef DTr_2::Vertex_handle  argument_type;
+  typedef std::pair<FT, bool>   result_type;
+
+  const Vertex_index_map& idx;
+  jlcxx::ArrayRef<double> values;
+
+  result_type operator()(const argument_type& vh) const {
+    auto it = idx.find(vh);
+    return it != idx.end() ?
+      result_type(FT(values[it->second]), true) :
+      result_type(FT(0), false);
+  }
+};
+
+struct Vertex_gradient {
+  typedef DTr_2::Vertex_handle       argument_type;
+  typedef std::pair<Vector_2, bool>  result_type;
+
+  const Vertex_index_map& idx;
+  jlcxx::ArrayRef<double> gradients;
+
+  result_type operator()(const argument_type& vh) const {
+    auto it = idx.find(vh);
+    if (it == idx.end()) return result_type(CGAL::NULL_VECTOR, false);
+    const double gx = gradients[2 * it->second],
+                 gy = gradients[2 * it->second + 1];
+    return result_type(Vector_2(gx, gy), gx == gx && gy == gy); // NaN check
+  }
+};
+
+// Natural neighbor coordinates of p, returning their normalization factor,
+// which is zero when p lies outside the convex hull.
+FT
+nn_coordinates(const DTr_2& dt, const Point_2& p,
+               std::vector<Coordinate_2>& coords, DTr_2::Face_handle hint) {
+  coords.clear();
+  auto res = CGAL::natural_neighbor_coordinates_2(dt, p,
+    std::back_inserter(coords), CGAL::Identity<Coordinate_2>(), hint);
+  return res.third ? res.second : FT(0);
+}
+
+void
+check_sizes(const DTr_2& dt, jlcxx::ArrayRef<double> out,
+            jlcxx::ArrayRef<double> values, jlcxx::ArrayRef<double> xy) {
+  if (values.size() != dt.number_of_vertices()) {
+    throw std::invalid_argument("#values != #vertices");
+  }
+  if (2 * out.size() != xy.size()) {
+    throw std::invalid_argument("output and query sizes differ");
+  }
+}
+
+// Evaluates f(coords, norm, p) at every query point of the packed xy
+// coordinates, writing NaN for those outside the convex hull.  Queries are
+// split in ranges, each walking from the previous query's neighborhood.
+template<typename F>
+void
+interpolate(const DTr_2& dt, jlcxx::ArrayRef<double> out,
+            jlcxx::ArrayRef<double> xy, const F& f) {
+  parallel_for_ranges(out.size(), [&](const std::size_t b, const std::size_t e) {
+    std::vector<Coordinate_2> coords;
+    DTr_2::Face_handle hint;
+    for (std::size_t i = b; i < e; ++i) {
+      const Point_2 p(xy[2 * i], xy[2 * i + 1]);
+      const FT norm = nn_coordinates(dt, p, coords, hint);
+      if (norm == 0) {
+        out[i] = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      out[i] = f(coords, norm, p);
+      hint = coords.front().first->face();
+    }
+  });
+}
+
+void wrap_interpolation_2(jlcxx::Module& cgal) {
+  cgal.method("natural_neighbor_coordinates", [](const DTr_2& dt,
+                                                 const Point_2& p) {
+    std::vector<Coordinate_2> coords;
+    const FT norm = nn_coordinates(dt, p, coords, DTr_2::Face_handle());
+
+    auto idx = vertex_indices(dt);
+    jlcxx::Array<jlcxx::cxxint_t> vs;
+    jlcxx::Array<double> ws;
+    for (const Coordinate_2& c : coords) {
+      vs.push_back(idx[c.first] + 1);
+      ws.push_back(CGAL::to_double(c.second / norm));
+    }
+    return std::make_tuple(vs, ws);
+  });
+
+  // Gradients are packed as gx, gy pairs, NaN for hull vertices.
+  cgal.method("sibson_gradient_fitting", [](const DTr_2& dt,
+                                            jlcxx::ArrayRef<double> values) {
+    if (values.size() != dt.number_of_vertices()) {
+      throw std::invalid_argument("#values != #vertices");
+    }
+    if (dt.dimension() != 2) {
+      throw std::invalid_argument("triangulation must be 2-dimensional");
+    }
+
+    const Vertex_index_map idx = vertex_indices(dt);
+    const std::vector<DTr_2::Vertex_handle> vhs = vertex_handles(dt);
+    std::vector<double> grads(2 * vhs.size(),
+                              std::numeric_limits<double>::quiet_NaN());
+    const Vertex_value value_function{idx, values};
+
+    parallel_for(vhs.size(), [&](const std::size_t i) {
+      // The neighborhood of a hull vertex includes the infinite vertex.
+      if (dt.is_edge(vhs[i], dt.infinite_vertex())) return;
+      std::vector<Coordinate_2> coords;
+      auto res = CGAL::natural_neighbor_coordinates_2(dt, vhs[i],
+        std::back_inserter(coords), CGAL::Identity<Coordinate_2>());
+      if (!res.third) return;
+
+      const Vector_2 g = CGAL::sibson_gradient_fitting(coords.begin(),
+        coords.end(), res.second, vhs[i]->point(), FT(values[i]),
+        value_function, Gradient_traits_2());
+      grads[2 * i]     = CGAL::to_double(g.x());
+      grads[2 * i + 1] = CGAL::to_double(g.y());
+    });
+
+    return collect(grads.begin(), grads.end());
+  });
+
+  cgal.method("linear_interpolation!", [](jlcxx::ArrayRef<double> out,
+                                          const DTr_2& dt,
+                                          jlcxx::ArrayRef<double> values,
+                                          jlcxx::ArrayRef<double> xy) {
+    check_sizes(dt, out, values, xy);
+    const Vertex_index_map idx = vertex_indices(dt);
+    const Vertex_value value_function{idx, values};
+
+    interpolate(dt, out, xy, [&](const std::vector<Coordinate_2>& coords,
+                                 const FT& norm, const Point_2&) {
+      return CGAL::to_double(CGAL::linear_interpolation(coords.begin(),
+        coords.end(), norm, value_function));
+    });
+    return out;
+  });
+
+  cgal.method("sibson_c1_interpolation!", [](jlcxx::ArrayRef<double> out,
+                                             const DTr_2& dt,
+                                             jlcxx::ArrayRef<double> values,
+                                             jlcxx::ArrayRef<double> gradients,
+                                             jlcxx::ArrayRef<double> xy) {
+    check_sizes(dt, out, values, xy);
+    if (gradients.size() != 2 * values.size()) {
+      throw std::invalid_argument("#gradients != 2 * #values");
+    }
+    const Vertex_index_map idx = vertex_indices(dt);
+    const Vertex_value value_function{idx, values};
+    const Vertex_gradient gradient_function{idx, gradients};
+
+    interpolate(dt, out, xy, [&](const std::vector<Coordinate_2>& coords,
+                                 const FT& norm, const Point_2& p) {
+      auto res = CGAL::sibson_c1_interpolation(coords.begin(), coords.end(),
+        norm, p, value_function, gradient_function, Gradient_traits_2());
+      return res.second ?
+        CGAL::to_double(res.first) :
+        std::numeric_limits<double>::quiet_NaN();
+    });
+    return out;
+  });
+}
+
+} // jlcgal
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <jlcxx/module.hpp>
+
+#include "parallel.hpp"
+#include "triangulation.hpp"
+#include "utils.hpp"
+#include "voronoi_cells.hpp"
+
+namespace jlcgal {
+
+// Lloyd relaxation of packed xy coordinates within a rectangular domain:
+// every iteration moves each site to the centroid of its clipped Voronoi
+// cell, until no site moves by more than `tolerance`.  The triangulation
+// is kept across iterations, vertices being moved in place.  Returns the
+// number of iterations performed.  Duplicate points are left where they are.
+jlcxx::cxxint_t
+lloyd_relax(jlcxx::ArrayRef<double> xy, const Iso_rectangle_2& domain,
+            const jlcxx::cxxint_t iterations, const double tolerance) {
+  if (xy.size() % 2 != 0) {
+    throw std::invalid_argument("coordinates must come in xy pairs");
+  }
+  if (iterations < 0) {
+    throw std::invalid_argument("#iterations must be non-negative");
+  }
+
+  std::vector<std::pair<Point_2, std::size_t>> ps;
+  ps.reserve(xy.size() / 2);
+  for (std::size_t i = 0; i < xy.size() / 2; ++i) {
+    ps.emplace_back(Point_2(xy[2 * i], xy[2 * i + 1]), i);
+  }
+  Indexed_DTr_2 dt(ps.begin(), ps.end());
+
+  jlcxx::cxxint_t it = 0;
+  while (it < iterations) {
+    ++it;
+    const std::vector<Indexed_DTr_2::Vertex_handle> vhs = vertex_handles(dt);
+    const std::vector<Cell_2> cells = clipped_cells(dt, domain);
+    std::vector<Cell_point_2> centroids(cells.size());
+    std::vector<char> moves(cells.size(), 0);
+    parallel_for(cells.size(), [&](const std::size_t i) {
+      double area;
+      cell_area_centroid(cells[i], area, centroids[i]);
+      moves[i] = !cells[i].empty();
+    });
+
+    double displacement = 0;
+    for (std::size_t i = 0; i < vhs.size(); ++i) {
+      if (!moves[i]) continue;
+      const Cell_point_2 p = cell_point(vhs[i]->point());
+      displacement = std::max(displacement,
+        std::hypot(centroids[i][0] - p[0], centroids[i][1] - p[1]));
+      dt.move_if_no_collision(vhs[i], Point_2(centroids[i][0], centroids[i][1]));
+    }
+    if (displacement <= tolerance) break;
+  }
+
+  for (auto v = dt.finite_vertices_begin(); v != dt.finite_vertices_end(); ++v) {
+    const Cell_point_2 p = cell_point(v->point());
+    xy[2 * v->info()]     = p[0];
+    xy[2 * v->info() + 1] = p[1];
+  }
+  return it;
+}
+
+void wrap_lloyd_relaxation_2(jlcxx::Module& cgal) {
+  cgal.method("lloyd_relax!", &lloyd_relax);
+}
+
+} // jlcgal
@@ -0,0 +1,168 @@
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <CGAL/Partition_traits_2.h>
+#include <CGAL/Polygon_triangulation_decomposition_2.h>
+#include <CGAL/partition_2.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include "parallel.hpp"
+#include "polygon_2.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+typedef CGAL::Partition_traits_2<Kernel>::Polygon_2 Partition_polygon_2;
+
+// Parts of a polygon as 0-based index lists into its vertices (outer
+// boundary first, then holes), with CSR offsets counting indices.
+struct Polygon_parts_2 {
+  std::vector<std::size_t> indices, offsets = {0};
+};
+
+inline void
+index_ring(const Polygon_2& ring, std::map<Point_2, std::size_t>& idx,
+           std::size_t& n) {
+  for (auto v = ring.vertices_begin(); v != ring.vertices_end(); ++v, ++n) {
+    idx.emplace(*v, n);
+  }
+}
+
+// Parts only ever have input vertices as their vertices, which are mapped
+// back to their (first) index.
+template<typename InputIterator>
+void
+index_parts(InputIterator first, InputIterator beyond,
+            const std::map<Point_2, std::size_t>& idx, Polygon_parts_2& out) {
+  for (; first != beyond; ++first) {
+    for (auto v = first->vertices_begin(); v != first->vertices_end(); ++v) {
+      out.indices.push_back(idx.at(*v));
+    }
+    out.offsets.push_back(out.indices.size());
+  }
+}
+
+// Partitions of simple polygons, which may come in either orientation; the
+// parts are counterclockwise.
+template<typename Partition>
+Polygon_parts_2
+partition(const Polygon_2& poly, const Partition& f) {
+  std::map<Point_2, std::size_t> idx;
+  std::size_t n = 0;
+  index_ring(poly, idx, n);
+
+  Polygon_2 p(poly);
+  if (p.size() > 2 && p.is_clockwise_oriented()) p.reverse_orientation();
+  std::list<Partition_polygon_2> parts;
+  f(p, std::back_inserter(parts));
+
+  Polygon_parts_2 res;
+  index_parts(parts.begin(), parts.end(), idx, res);
+  return res;
+}
+
+inline Polygon_parts_2
+triangulation_decomposition(const Polygon_with_holes_2& pwh) {
+  if (pwh.outer_boundary().is_empty()) return Polygon_parts_2();
+  std::map<Point_2, std::size_t> idx;
+  std::size_t n = 0;
+  index_ring(pwh.outer_boundary(), idx, n);
+  for (auto h = pwh.holes_begin(); h != pwh.holes_end(); ++h) {
+    index_ring(*h, idx, n);
+  }
+
+  std::list<Polygon_2> parts;
+  CGAL::Polygon_triangulation_decomposition_2<Kernel>()(pwh,
+                                                        std::back_inserter(parts));
+
+  Polygon_parts_2 res;
+  index_parts(parts.begin(), parts.end(), idx, res);
+  return res;
+}
+
+inline std::tuple<jlcxx::Array<jlcxx::cxxint_t>, jlcxx::Array<jlcxx::cxxint_t>>
+pack_parts(const Polygon_parts_2& parts) {
+  jlcxx::Array<jlcxx::cxxint_t> indices;
+  for (const std::size_t i : parts.indices) indices.push_back(i + 1);
+  return std::make_tuple(indices,
+                         collect(parts.offsets.begin(), parts.offsets.end()));
+}
+
+// Batched over polygons: 1-based index lists into the vertices of their own
+// polygon, with CSR offsets of the parts into the indices and of the
+// polygons into the parts.
+template<typename P, typename F>
+std::tuple<jlcxx::Array<jlcxx::cxxint_t>, jlcxx::Array<jlcxx::cxxint_t>,
+           jlcxx::Array<jlcxx::cxxint_t>>
+pack_parts(const std::vector<P>& ps, const F& f) {
+  std::vector<Polygon_parts_2> parts(ps.size());
+  parallel_for(ps.size(), [&](const std::size_t i) { parts[i] = f(ps[i]); });
+
+  jlcxx::Array<jlcxx::cxxint_t> indices, offsets, poffsets;
+  jlcxx::cxxint_t ni = 0, np = 0;
+  offsets.push_back(0);
+  poffsets.push_back(0);
+  for (const Polygon_parts_2& pp : parts) {
+    for (const std::size_t i : pp.indices) indices.push_back(i + 1);
+    for (std::size_t k = 1; k < pp.offsets.size(); ++k) {
+      offsets.push_back(ni + pp.offsets[k]);
+    }
+    ni += pp.indices.size();
+    np += pp.offsets.size() - 1;
+    poffsets.push_back(np);
+  }
+  return std::make_tuple(indices, offsets, poffsets);
+}
+
+#define PARTITION_2(F) \
+  { \
+    auto f = [](const Polygon_2& p) { \
+      return partition(p, [](const Polygon_2& q, auto oi) { \
+        CGAL::F(q.vertices_begin(), q.vertices_end(), oi); \
+      }); \
+    }; \
+    cgal.method(#F, [f](const Polygon_2& p) { return pack_parts(f(p)); }); \
+    cgal.method(#F, [f](jlcxx::ArrayRef<Polygon_2> ps) { \
+      return pack_parts(std::vector<Polygon_2>(ps.begin(), ps.end()), f); \
+    }); \
+  }
+
+void wrap_partition_2(jlcxx::Module& cgal) {
+  // Partitioning Functions
+  PARTITION_2(approx_convex_partition_2);
+  PARTITION_2(greene_approx_convex_partition_2);
+  PARTITION_2(optimal_convex_partition_2);
+  PARTITION_2(y_monotone_partition_2);
+
+  // Decompositions, of polygons with holes too
+  cgal.method("triangulation_decomposition_2", [](const Polygon_2& p) {
+    return pack_parts(triangulation_decomposition(Polygon_with_holes_2(p)));
+  });
+  cgal.method("triangulation_decomposition_2", [](const Polygon_with_holes_2& pwh) {
+    return pack_parts(triangulation_decomposition(pwh));
+  });
+  cgal.method("triangulation_decomposition_2", [](jlcxx::ArrayRef<Polygon_2> ps) {
+    return pack_parts(std::vector<Polygon_2>(ps.begin(), ps.end()),
+                      [](const Polygon_2& p) {
+      return triangulation_decomposition(Polygon_with_holes_2(p));
+    });
+  });
+  cgal.method("triangulation_decomposition_2",
+              [](jlcxx::ArrayRef<Polygon_with_holes_2> ps) {
+    return pack_parts(std::vector<Polygon_with_holes_2>(ps.begin(), ps.end()),
+                      &triangulation_decomposition);
+  });
+  cgal.method("triangulation_decomposition_2", [](const Polygon_collection_2& pc) {
+    return pack_parts(pc, &triangulation_decomposition);
+  });
+}
+
+#undef PARTITION_2
+
+} // jlcgal
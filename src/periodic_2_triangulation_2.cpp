@@ -0,0 +1,128 @@
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <CGAL/Handle_hash_function.h>
+#include <CGAL/Periodic_2_Delaunay_triangulation_2.h>
+#include <CGAL/Periodic_2_Delaunay_triangulation_traits_2.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include <julia.h>
+
+#include "kernel.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+typedef CGAL::Periodic_2_Delaunay_triangulation_traits_2<Kernel> P2Gt;
+typedef CGAL::Periodic_2_Delaunay_triangulation_2<P2Gt>          PDTr_2;
+
+// CGAL only supports square periodic domains.
+const Iso_rectangle_2&
+check_domain(const Iso_rectangle_2& domain) {
+  if (domain.xmax() - domain.xmin() != domain.ymax() - domain.ymin()) {
+    throw std::invalid_argument("periodic domain must be a square");
+  }
+  return domain;
+}
+
+// Vertices are referred to by their position in the unique vertex order,
+// i.e., the order in which `points` lists them.  In the 1-sheeted covering,
+// there are no copies, so it matches the stored vertex order.
+std::unordered_map<PDTr_2::Vertex_handle, std::size_t, CGAL::Handle_hash_function>
+periodic_vertex_indices(const PDTr_2& pt) {
+  std::unordered_map<PDTr_2::Vertex_handle, std::size_t,
+                     CGAL::Handle_hash_function> idx;
+  for (auto it = pt.vertices_begin(); it != pt.vertices_end(); ++it) {
+    idx.emplace(it, idx.size());
+  }
+  return idx;
+}
+
+void wrap_periodic_2_triangulation_2(jlcxx::Module& cgal) {
+  const std::string pdtr_name = "PeriodicDelaunayTriangulation2";
+
+  auto pdtr = cgal.add_type<PDTr_2>(pdtr_name)
+    // Creation
+    .constructor<const PDTr_2&>()
+    .method(pdtr_name, [](const Iso_rectangle_2& domain) {
+      return jlcxx::create<PDTr_2>(check_domain(domain));
+    })
+    .method(pdtr_name, [](const Iso_rectangle_2& domain,
+                          jlcxx::ArrayRef<Point_2> ps) {
+      return jlcxx::create<PDTr_2>(ps.begin(), ps.end(), check_domain(domain));
+    })
+    // Access Functions
+    .method("domain", [](const PDTr_2& pt) -> const Iso_rectangle_2& {
+      return pt.domain();
+    })
+    .method("number_of_vertices", &PDTr_2::number_of_vertices)
+    .method("number_of_faces",    &PDTr_2::number_of_faces)
+    .method("is_triangulation_in_1_sheet", &PDTr_2::is_triangulation_in_1_sheet)
+    .method("points", [](const PDTr_2& pt) {
+      jlcxx::Array<Point_2> jlarr;
+      for (auto it = pt.unique_vertices_begin();
+           it != pt.unique_vertices_end(); ++it) {
+        jlarr.push_back(it->point());
+      }
+      return jlarr;
+    })
+    // Queries
+    .method("nearest_vertex", [](const PDTr_2& pt, const Point_2& p) {
+      return pt.nearest_vertex(p)->point();
+    })
+    // Flat Export, for each face (in order) and each of its three vertices:
+    // the 1-based vertex index into `points`, the 1-based neighbor face index
+    // across the opposite edge, and the x and y offsets (in domain periods)
+    // of the vertex copy that the face actually uses.
+    .method("periodic_connectivity", [](const PDTr_2& pt) {
+      if (!pt.is_triangulation_in_1_sheet()) {
+        throw std::runtime_error("triangulation is not in the 1-sheeted covering");
+      }
+
+      auto vidx = periodic_vertex_indices(pt);
+      std::unordered_map<PDTr_2::Face_handle, std::size_t,
+                         CGAL::Handle_hash_function> fidx;
+      for (auto it = pt.faces_begin(); it != pt.faces_end(); ++it) {
+        fidx.emplace(it, fidx.size());
+      }
+
+      jlcxx::Array<jlcxx::cxxint_t> vs, ns, offsets;
+      for (auto it = pt.faces_begin(); it != pt.faces_end(); ++it) {
+        const PDTr_2::Periodic_triangle tri = pt.periodic_triangle(it);
+        for (int i = 0; i < 3; ++i) {
+          const PDTr_2::Offset& o = tri[i].second;
+          vs.push_back(vidx[it->vertex(i)] + 1);
+          ns.push_back(fidx[it->neighbor(i)] + 1);
+          offsets.push_back(o.x());
+          offsets.push_back(o.y());
+        }
+      }
+      return std::make_tuple(vs, ns, offsets);
+    })
+    // Miscellaneous
+    .method("is_valid", [](const PDTr_2& pt) { return pt.is_valid(); })
+    ;
+  cgal.set_override_module(jl_base_module);
+  pdtr
+    // Insertion and Removal
+    .method("insert!", [](PDTr_2& pt, jlcxx::ArrayRef<Point_2> ps) -> PDTr_2& {
+      pt.insert(ps.begin(), ps.end(), true);
+      return pt;
+    })
+    .method("push!", [](PDTr_2& pt, const Point_2& p) -> PDTr_2& {
+      pt.push_back(p);
+      return pt;
+    })
+    .method("empty!", [](PDTr_2& pt) -> PDTr_2& {
+      pt.clear();
+      return pt;
+    })
+    ;
+  cgal.unset_override_module();
+}
+
+} // jlcgal
@@ -1,8 +1,12 @@
+#include <cstddef>
+#include <stdexcept>
+
 #include <jlcxx/module.hpp>
 
 #include <julia.h>
 
 #include "io.hpp"
+#include "parallel.hpp"
 #include "polygon_2.hpp"
 #include "utils.hpp"
 
@@ -12,6 +16,65 @@ template<typename P1, typename P2>
 bool
 eqpoly(const P1& p1, const P2& p2) { return p1 == p2; }
 
+// Polygons from GeoArrow-style buffers: packed xy coordinates, 0-based
+// offsets of the rings into the points and of the polygons into the rings,
+// the first ring of each polygon being its outer boundary.  Rings may
+// repeat their first point at the end.  Polygons without rings are empty.
+Polygon_collection_2
+polygon_collection(jlcxx::ArrayRef<double> xy,
+                   jlcxx::ArrayRef<jlcxx::cxxint_t> ring_offsets,
+                   jlcxx::ArrayRef<jlcxx::cxxint_t> polygon_offsets) {
+  if (xy.size() % 2 != 0) {
+    throw std::invalid_argument("coordinates must come in xy pairs");
+  }
+  if (ring_offsets.size() == 0 || ring_offsets[0] != 0 ||
+      polygon_offsets.size() == 0 || polygon_offsets[0] != 0) {
+    throw std::invalid_argument("offsets must start at 0");
+  }
+  const std::size_t nrings = ring_offsets.size() - 1,
+                    npolys = polygon_offsets.size() - 1;
+  for (std::size_t i = 0; i < nrings; ++i) {
+    if (ring_offsets[i] > ring_offsets[i + 1]) {
+      throw std::invalid_argument("ring offsets must be non-decreasing");
+    }
+  }
+  if (static_cast<std::size_t>(ring_offsets[nrings]) > xy.size() / 2) {
+    throw std::out_of_range("ring offsets exceed the coordinates");
+  }
+  for (std::size_t i = 0; i < npolys; ++i) {
+    if (polygon_offsets[i] > polygon_offsets[i + 1]) {
+      throw std::invalid_argument("polygon offsets must be non-decreasing");
+    }
+  }
+  if (static_cast<std::size_t>(polygon_offsets[npolys]) > nrings) {
+    throw std::out_of_range("polygon offsets exceed the rings");
+  }
+
+  auto ring = [&](const std::size_t r) {
+    std::size_t b = ring_offsets[r], e = ring_offsets[r + 1];
+    if (e - b > 1 && xy[2 * b] == xy[2 * (e - 1)] &&
+        xy[2 * b + 1] == xy[2 * (e - 1) + 1]) --e;
+    Polygon_2 poly;
+    for (std::size_t i = b; i < e; ++i) {
+      poly.push_back(Point_2(xy[2 * i], xy[2 * i + 1]));
+    }
+    return poly;
+  };
+
+  Polygon_collection_2 pc;
+  pc.resize(npolys);
+  parallel_for(npolys, [&](const std::size_t i) {
+    const std::size_t r = polygon_offsets[i], e = polygon_offsets[i + 1];
+    if (r == e) return;
+    Polygon_with_holes_2& pwh = pc[i];
+    pwh.outer_boundary() = ring(r);
+    for (std::size_t h = r + 1; h < e; ++h) {
+      pwh.add_hole(ring(h));
+    }
+  });
+  return pc;
+}
+
 void wrap_polygon_2(jlcxx::Module& cgal) {
   const std::string poly_2_name = "Polygon2";
 
@@ -142,6 +205,30 @@ void wrap_polygon_2(jlcxx::Module& cgal) {
     .TO_STRING(Polygon_with_holes_2)
     ;
 
+  typedef Polygon_collection_2 PC;
+
+  auto pc_2 = cgal.add_type<PC>("PolygonCollection2")
+    // Creation
+    .method("PolygonCollection2", [](jlcxx::ArrayRef<double> xy,
+                                     jlcxx::ArrayRef<jlcxx::cxxint_t> rings,
+                                     jlcxx::ArrayRef<jlcxx::cxxint_t> polys) {
+      return jlcxx::create<PC>(polygon_collection(xy, rings, polys));
+    })
+    // Access Functions
+    .method("polygons", [](const PC& pc) {
+      return collect(pc.begin(), pc.end());
+    })
+    ;
+  cgal.set_override_module(jl_base_module);
+  pc_2
+    .method("length", [](const PC& pc) { return pc.size(); })
+    .method("isempty", [](const PC& pc) { return pc.empty(); })
+    .method("getindex", [](const PC& pc, const jlcxx::cxxint_t i) {
+      return pc.at(i - 1);
+    })
+    ;
+  cgal.unset_override_module();
+
   cgal.set_override_module(jl_base_module);
   cgal.method("==", &eqpoly<Polygon_2, Polygon_2>);
   cgal.method("==", &eqpoly<Polygon_2, Polygon_with_holes_2>);
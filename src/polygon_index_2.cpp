@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <jlcxx/module.hpp>
+
+#include "parallel.hpp"
+#include "polygon_2.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+// Point location among many polygons: a uniform grid over the bounding
+// boxes of the polygons yields candidates, and each candidate keeps its
+// edges bucketed into horizontal slabs, so that a query only tests the
+// edges of a single slab.  Crossing tests are exact.  Points on a boundary
+// belong to the polygon.
+class Polygon_index_2 {
+public:
+  template<typename InputIterator>
+  Polygon_index_2(InputIterator first, InputIterator beyond) {
+    for (; first != beyond; ++first) add_polygon(*first);
+    build_grid();
+  }
+
+  std::size_t number_of_polygons() const { return _polygons.size(); }
+
+  // 1-based index of the first polygon containing p, 0 if there are none.
+  std::size_t locate(const Point_2& p) const {
+    if (_polygons.empty()) return 0;
+    const double x = CGAL::to_double(p.x()), y = CGAL::to_double(p.y());
+    if (x < _xmin || x > _xmax || y < _ymin || y > _ymax) return 0;
+    const std::size_t c = cell(x, _xmin, _dx, _nx) + _nx * cell(y, _ymin, _dy, _ny);
+    for (std::size_t k = _cell_offsets[c]; k < _cell_offsets[c + 1]; ++k) {
+      if (contains(_polygons[_cell_polygons[k]], p, x, y)) {
+        return _cell_polygons[k] + 1;
+      }
+    }
+    return 0;
+  }
+
+private:
+  struct Edge {
+    Point_2 lower, upper;
+  };
+
+  struct Indexed_polygon {
+    double xmin, xmax, ymin, ymax, dy;
+    std::vector<Edge> edges;
+    std::vector<std::size_t> slab_offsets, slab_edges;
+  };
+
+  static std::size_t cell(const double v, const double min, const double d,
+                          const std::size_t n) {
+    return std::min(n - 1, static_cast<std::size_t>(std::max(0., (v - min) / d)));
+  }
+
+  static void add_ring(Indexed_polygon& ip, const Polygon_2& ring) {
+    for (auto e = ring.edges_begin(); e != ring.edges_end(); ++e) {
+      const Segment_2 seg = *e;
+      const Point_2 s = seg.source(), t = seg.target();
+      ip.edges.push_back(CGAL::compare_y(s, t) == CGAL::LARGER ? Edge{t, s}
+                                                               : Edge{s, t});
+    }
+  }
+
+  void add_polygon(const Polygon_2& p) {
+    add_polygon(Polygon_with_holes_2(p));
+  }
+
+  void add_polygon(const Polygon_with_holes_2& pwh) {
+    Indexed_polygon ip;
+    add_ring(ip, pwh.outer_boundary());
+    for (auto h = pwh.holes_begin(); h != pwh.holes_end(); ++h) add_ring(ip, *h);
+
+    // Interval bounding boxes keep buckets conservative for exact kernels.
+    CGAL::Bbox_2 bb;
+    for (const Edge& e : ip.edges) bb += e.lower.bbox() + e.upper.bbox();
+    ip.xmin = bb.xmin(); ip.xmax = bb.xmax();
+    ip.ymin = bb.ymin(); ip.ymax = bb.ymax();
+
+    const std::size_t nslabs = std::max<std::size_t>(1, ip.edges.size() / 4);
+    ip.dy = (ip.ymax - ip.ymin) / nslabs;
+    if (!(ip.dy > 0)) ip.dy = 1;
+    std::vector<std::pair<std::size_t, std::size_t>> spans(ip.edges.size());
+    ip.slab_offsets.assign(nslabs + 1, 0);
+    for (std::size_t i = 0; i < ip.edges.size(); ++i) {
+      const CGAL::Bbox_2 eb = ip.edges[i].lower.bbox() + ip.edges[i].upper.bbox();
+      spans[i] = std::make_pair(cell(eb.ymin(), ip.ymin, ip.dy, nslabs),
+                                cell(eb.ymax(), ip.ymin, ip.dy, nslabs));
+      for (std::size_t s = spans[i].first; s <= spans[i].second; ++s) {
+        ++ip.slab_offsets[s + 1];
+      }
+    }
+    for (std::size_t s = 0; s < nslabs; ++s) {
+      ip.slab_offsets[s + 1] += ip.slab_offsets[s];
+    }
+    ip.slab_edges.resize(ip.slab_offsets.back());
+    std::vector<std::size_t> fill(ip.slab_offsets.begin(), ip.slab_offsets.end() - 1);
+    for (std::size_t i = 0; i < ip.edges.size(); ++i) {
+      for (std::size_t s = spans[i].first; s <= spans[i].second; ++s) {
+        ip.slab_edges[fill[s]++] = i;
+      }
+    }
+    _polygons.push_back(std::move(ip));
+  }
+
+  // Polygons are registered in every grid cell their bounding box overlaps.
+  void build_grid() {
+    _xmin = _ymin =  std::numeric_limits<double>::infinity();
+    _xmax = _ymax = -std::numeric_limits<double>::infinity();
+    for (const Indexed_polygon& ip : _polygons) {
+      if (ip.edges.empty()) continue;
+      _xmin = std::min(_xmin, ip.xmin); _xmax = std::max(_xmax, ip.xmax);
+      _ymin = std::min(_ymin, ip.ymin); _ymax = std::max(_ymax, ip.ymax);
+    }
+    _nx = _ny = std::max<std::size_t>(1, std::ceil(std::sqrt(_polygons.size())));
+    _dx = (_xmax - _xmin) / _nx;
+    _dy = (_ymax - _ymin) / _ny;
+    if (!(_xmin <= _xmax)) _xmin = _xmax = _ymin = _ymax = 0;
+    if (!(_dx > 0)) _dx = 1;
+    if (!(_dy > 0)) _dy = 1;
+
+    _cell_offsets.assign(_nx * _ny + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+      std::vector<std::size_t> fill(_cell_offsets.begin(), _cell_offsets.end() - 1);
+      for (std::size_t i = 0; i < _polygons.size(); ++i) {
+        const Indexed_polygon& ip = _polygons[i];
+        if (ip.edges.empty()) continue;
+        const std::size_t i0 = cell(ip.xmin, _xmin, _dx, _nx),
+                          i1 = cell(ip.xmax, _xmin, _dx, _nx),
+                          j0 = cell(ip.ymin, _ymin, _dy, _ny),
+                          j1 = cell(ip.ymax, _ymin, _dy, _ny);
+        for (std::size_t j = j0; j <= j1; ++j) {
+          for (std::size_t k = i0; k <= i1; ++k) {
+            if (pass == 0) {
+              ++_cell_offsets[k + _nx * j + 1];
+            } else {
+              _cell_polygons[fill[k + _nx * j]++] = i;
+            }
+          }
+        }
+      }
+      if (pass == 0) {
+        for (std::size_t c = 0; c < _nx * _ny; ++c) {
+          _cell_offsets[c + 1] += _cell_offsets[c];
+        }
+        _cell_polygons.resize(_cell_offsets.back());
+      }
+    }
+  }
+
+  // Crossing number over the edges of the slab of p, with edges spanning
+  // [lower, upper) in y, so that vertices are counted once.
+  static bool contains(const Indexed_polygon& ip, const Point_2& p,
+                       const double x, const double y) {
+    if (x < ip.xmin || x > ip.xmax || y < ip.ymin || y > ip.ymax) return false;
+    const std::size_t nslabs = ip.slab_offsets.size() - 1;
+    const std::size_t s = cell(y, ip.ymin, ip.dy, nslabs);
+    bool inside = false;
+    for (std::size_t k = ip.slab_offsets[s]; k < ip.slab_offsets[s + 1]; ++k) {
+      const Edge& e = ip.edges[ip.slab_edges[k]];
+      const CGAL::Comparison_result cl = CGAL::compare_y(p, e.lower),
+                                    cu = CGAL::compare_y(p, e.upper);
+      if (cl == CGAL::SMALLER || cu == CGAL::LARGER) continue;
+      const CGAL::Orientation o = CGAL::orientation(e.lower, e.upper, p);
+      if (o == CGAL::COLLINEAR) {
+        if (CGAL::collinear_are_ordered_along_line(e.lower, p, e.upper)) {
+          return true;
+        }
+        continue;
+      }
+      if (cu == CGAL::SMALLER && o == CGAL::LEFT_TURN) inside = !inside;
+    }
+    return inside;
+  }
+
+  std::vector<Indexed_polygon> _polygons;
+  double _xmin = 0, _xmax = 0, _ymin = 0, _ymax = 0, _dx = 1, _dy = 1;
+  std::size_t _nx = 1, _ny = 1;
+  std::vector<std::size_t> _cell_offsets, _cell_polygons;
+};
+
+void wrap_polygon_index_2(jlcxx::Module& cgal) {
+  typedef Polygon_index_2 PI;
+
+  cgal.add_type<PI>("PolygonIndex2")
+    // Creation
+    .method("PolygonIndex2", [](jlcxx::ArrayRef<Polygon_2> ps) {
+      return jlcxx::create<PI>(ps.begin(), ps.end());
+    })
+    .method("PolygonIndex2", [](jlcxx::ArrayRef<Polygon_with_holes_2> ps) {
+      return jlcxx::create<PI>(ps.begin(), ps.end());
+    })
+    .method("PolygonIndex2", [](const Polygon_collection_2& pc) {
+      return jlcxx::create<PI>(pc.begin(), pc.end());
+    })
+    // Access Functions
+    .method("number_of_polygons", &PI::number_of_polygons)
+    // Queries, returning 1-based polygon indices (0 if outside all of them)
+    .method("locate", [](const PI& pi, const Point_2& p) {
+      return static_cast<jlcxx::cxxint_t>(pi.locate(p));
+    })
+    .method("locate", [](const PI& pi, jlcxx::ArrayRef<double> xy) {
+      if (xy.size() % 2 != 0) {
+        throw std::invalid_argument("coordinates must come in xy pairs");
+      }
+      std::vector<jlcxx::cxxint_t> res(xy.size() / 2);
+      parallel_for(res.size(), [&](const std::size_t i) {
+        res[i] = pi.locate(Point_2(xy[2 * i], xy[2 * i + 1]));
+      });
+      return collect(res.begin(), res.end());
+    })
+    ;
+}
+
+} // jlcgal
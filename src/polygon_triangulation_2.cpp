@@ -0,0 +1,162 @@
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <tuple>
+#include <vector>
+
+#include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/Constrained_triangulation_face_base_2.h>
+#include <CGAL/Triangulation_face_base_with_info_2.h>
+#include <CGAL/Triangulation_vertex_base_with_info_2.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include "parallel.hpp"
+#include "polygon_2.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+// Vertices know their index in the polygon's vertex order, faces their
+// nesting level: 0 outside, odd inside, each constraint crossed adding 1.
+typedef CGAL::Triangulation_vertex_base_with_info_2<std::size_t, Kernel> Ptr_vb_2;
+typedef CGAL::Constrained_triangulation_face_base_2<Kernel>              Ptr_cfb_2;
+typedef CGAL::Triangulation_face_base_with_info_2<int, Kernel, Ptr_cfb_2> Ptr_fb_2;
+typedef CGAL::Triangulation_data_structure_2<Ptr_vb_2, Ptr_fb_2>        Ptr_tds_2;
+typedef CGAL::Constrained_Delaunay_triangulation_2<Kernel, Ptr_tds_2>   Ptr_CDTr_2;
+
+typedef std::int32_t Triangle_index;
+
+inline void
+insert_ring(Ptr_CDTr_2& cdt, const Polygon_2& ring, std::size_t& n) {
+  std::vector<Ptr_CDTr_2::Vertex_handle> vhs;
+  vhs.reserve(ring.size());
+  Ptr_CDTr_2::Face_handle hint;
+  for (auto v = ring.vertices_begin(); v != ring.vertices_end(); ++v, ++n) {
+    const std::size_t nv = cdt.number_of_vertices();
+    vhs.push_back(cdt.insert(*v, hint));
+    if (cdt.number_of_vertices() != nv) vhs.back()->info() = n;
+    hint = vhs.back()->face();
+  }
+  for (std::size_t i = 0; i < vhs.size(); ++i) {
+    const auto a = vhs[i], b = vhs[(i + 1) % vhs.size()];
+    if (a != b) cdt.insert_constraint(a, b);
+  }
+}
+
+// Flood fills nesting levels from the infinite face, crossing constraints
+// only to seed the next level.
+inline void
+mark_domains(Ptr_CDTr_2& cdt) {
+  for (auto f = cdt.all_faces_begin(); f != cdt.all_faces_end(); ++f) {
+    f->info() = -1;
+  }
+  std::list<Ptr_CDTr_2::Edge> border;
+  auto flood = [&](Ptr_CDTr_2::Face_handle start, const int level) {
+    if (start->info() != -1) return;
+    std::list<Ptr_CDTr_2::Face_handle> queue(1, start);
+    while (!queue.empty()) {
+      const Ptr_CDTr_2::Face_handle f = queue.front();
+      queue.pop_front();
+      if (f->info() != -1) continue;
+      f->info() = level;
+      for (int i = 0; i < 3; ++i) {
+        const Ptr_CDTr_2::Face_handle n = f->neighbor(i);
+        if (n->info() != -1) continue;
+        if (f->is_constrained(i)) {
+          border.push_back(Ptr_CDTr_2::Edge(f, i));
+        } else {
+          queue.push_back(n);
+        }
+      }
+    }
+  };
+  flood(cdt.infinite_face(), 0);
+  while (!border.empty()) {
+    const Ptr_CDTr_2::Edge e = border.front();
+    border.pop_front();
+    const Ptr_CDTr_2::Face_handle n = e.first->neighbor(e.second);
+    flood(n, e.first->info() + 1);
+  }
+}
+
+// Triangles of the interior of a polygon, as 0-based counterclockwise index
+// triples into its vertices (outer boundary first, then holes), appended to
+// `out`.  Repeated points map to their first occurrence.  Returns the number
+// of triangles.
+inline std::size_t
+triangulate(const Polygon_with_holes_2& pwh, std::vector<Triangle_index>& out) {
+  Ptr_CDTr_2 cdt;
+  std::size_t n = 0;
+  insert_ring(cdt, pwh.outer_boundary(), n);
+  for (auto h = pwh.holes_begin(); h != pwh.holes_end(); ++h) {
+    insert_ring(cdt, *h, n);
+  }
+  if (cdt.dimension() < 2) return 0;
+  mark_domains(cdt);
+
+  std::size_t nt = 0;
+  for (auto f = cdt.finite_faces_begin(); f != cdt.finite_faces_end(); ++f) {
+    if (f->info() % 2 != 1) continue;
+    for (int i = 0; i < 3; ++i) {
+      out.push_back(static_cast<Triangle_index>(f->vertex(i)->info()));
+    }
+    ++nt;
+  }
+  return nt;
+}
+
+inline jlcxx::Array<Triangle_index>
+triangles(const Polygon_with_holes_2& pwh) {
+  std::vector<Triangle_index> ts;
+  triangulate(pwh, ts);
+  jlcxx::Array<Triangle_index> jlarr;
+  for (const Triangle_index i : ts) jlarr.push_back(i + 1);
+  return jlarr;
+}
+
+// Batched over polygons: triangles of all polygons as 1-based index triples
+// into the vertices of their own polygon, with CSR offsets counting
+// triangles.
+inline std::tuple<jlcxx::Array<Triangle_index>, jlcxx::Array<jlcxx::cxxint_t>>
+triangles(const std::vector<Polygon_with_holes_2>& pwhs) {
+  std::vector<std::vector<Triangle_index>> ts(pwhs.size());
+  parallel_for(pwhs.size(), [&](const std::size_t i) {
+    triangulate(pwhs[i], ts[i]);
+  });
+
+  jlcxx::Array<Triangle_index> indices;
+  jlcxx::Array<jlcxx::cxxint_t> offsets;
+  jlcxx::cxxint_t nt = 0;
+  offsets.push_back(0);
+  for (const std::vector<Triangle_index>& t : ts) {
+    for (const Triangle_index i : t) indices.push_back(i + 1);
+    nt += t.size() / 3;
+    offsets.push_back(nt);
+  }
+  return std::make_tuple(indices, offsets);
+}
+
+void wrap_polygon_triangulation_2(jlcxx::Module& cgal) {
+  cgal.method("triangulate", [](const Polygon_2& p) {
+    return triangles(Polygon_with_holes_2(p));
+  });
+  cgal.method("triangulate", [](const Polygon_with_holes_2& pwh) {
+    return triangles(pwh);
+  });
+  cgal.method("triangulate", [](jlcxx::ArrayRef<Polygon_2> ps) {
+    std::vector<Polygon_with_holes_2> pwhs;
+    pwhs.reserve(ps.size());
+    for (const Polygon_2& p : ps) pwhs.push_back(Polygon_with_holes_2(p));
+    return triangles(pwhs);
+  });
+  cgal.method("triangulate", [](jlcxx::ArrayRef<Polygon_with_holes_2> ps) {
+    return triangles(std::vector<Polygon_with_holes_2>(ps.begin(), ps.end()));
+  });
+  cgal.method("triangulate", [](const Polygon_collection_2& pc) {
+    return triangles(pc);
+  });
+}
+
+} // jlcgal
@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/Constrained_triangulation_plus_2.h>
+#include <CGAL/Polyline_simplification_2/Squared_distance_cost.h>
+#include <CGAL/Polyline_simplification_2/Stop_above_cost_threshold.h>
+#include <CGAL/Polyline_simplification_2/Stop_below_count_ratio_threshold.h>
+#include <CGAL/Polyline_simplification_2/Stop_below_count_threshold.h>
+#include <CGAL/Polyline_simplification_2/simplify.h>
+#include <CGAL/box_intersection_d.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include "parallel.hpp"
+#include "polygon_2.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+namespace PS = CGAL::Polyline_simplification_2;
+
+typedef PS::Vertex_base_2<Kernel>                                Ps_vb_2;
+typedef CGAL::Constrained_triangulation_face_base_2<Kernel>      Ps_fb_2;
+typedef CGAL::Triangulation_data_structure_2<Ps_vb_2, Ps_fb_2>   Ps_tds_2;
+typedef CGAL::Constrained_Delaunay_triangulation_2<Kernel, Ps_tds_2,
+                                                   CGAL::Exact_predicates_tag>
+                                                                 Ps_CDTr_2;
+typedef CGAL::Constrained_triangulation_plus_2<Ps_CDTr_2>        Ps_CTr_2;
+
+// Stop criteria, all with the squared distance cost: below a ratio of the
+// initial number of vertices, below a number of vertices, or above a
+// squared distance.
+enum Simplification_stop {
+  STOP_BELOW_COUNT_RATIO,
+  STOP_BELOW_COUNT,
+  STOP_ABOVE_COST
+};
+
+// Polylines as points with CSR offsets, rings not repeating their first
+// point.
+struct Polylines_2 {
+  std::vector<Point_2> points;
+  std::vector<std::size_t> offsets = {0};
+  std::vector<char> closed;
+
+  std::size_t size() const { return closed.size(); }
+
+  template<typename InputIterator>
+  void push_back(InputIterator first, InputIterator beyond, const bool c) {
+    points.insert(points.end(), first, beyond);
+    if (c && points.size() - offsets.back() > 1 &&
+        points.back() == points[offsets.back()]) points.pop_back();
+    offsets.push_back(points.size());
+    closed.push_back(c);
+  }
+};
+
+// Simplifies all polylines together, as constraints of a single
+// triangulation, so that they neither cross each other nor themselves, and
+// shared boundaries are simplified once.
+inline Polylines_2
+simplify(const Polylines_2& pls, const Simplification_stop stop,
+         const double threshold) {
+  if (threshold < 0) {
+    throw std::invalid_argument("threshold must be non-negative");
+  }
+
+  Ps_CTr_2 ct;
+  // Polylines of less than two points are no constraints, and kept as is.
+  std::vector<Ps_CTr_2::Constraint_id> cids(pls.size());
+  std::vector<char> constrained(pls.size(), 0);
+  for (std::size_t i = 0; i < pls.size(); ++i) {
+    auto b = pls.points.begin() + pls.offsets[i],
+         e = pls.points.begin() + pls.offsets[i + 1];
+    if (e - b < 2) continue;
+    cids[i] = ct.insert_constraint(b, e, pls.closed[i]);
+    constrained[i] = 1;
+  }
+
+  const PS::Squared_distance_cost cost;
+  switch (stop) {
+  case STOP_BELOW_COUNT_RATIO:
+    PS::simplify(ct, cost, PS::Stop_below_count_ratio_threshold(threshold));
+    break;
+  case STOP_BELOW_COUNT:
+    if (threshold != std::floor(threshold)) {
+      throw std::invalid_argument("count threshold must be an integer");
+    }
+    PS::simplify(ct, cost, PS::Stop_below_count_threshold(
+      static_cast<std::size_t>(threshold)));
+    break;
+  case STOP_ABOVE_COST:
+    PS::simplify(ct, cost, PS::Stop_above_cost_threshold(threshold));
+    break;
+  default:
+    throw std::invalid_argument("unknown stop criterion");
+  }
+
+  Polylines_2 res;
+  for (std::size_t i = 0; i < pls.size(); ++i) {
+    if (!constrained[i]) {
+      res.push_back(pls.points.begin() + pls.offsets[i],
+                    pls.points.begin() + pls.offsets[i + 1], pls.closed[i]);
+    } else {
+      res.push_back(ct.points_in_constraint_begin(cids[i]),
+                    ct.points_in_constraint_end(cids[i]), pls.closed[i]);
+    }
+  }
+  return res;
+}
+
+// The given polylines of packed xy coordinates with CSR offsets counting
+// points, all open or all closed.
+inline Polylines_2
+polylines(jlcxx::ArrayRef<double> xy, jlcxx::ArrayRef<jlcxx::cxxint_t> offsets,
+          const bool closed, const std::vector<std::size_t>& indices) {
+  Polylines_2 pls;
+  std::vector<Point_2> ps;
+  for (std::size_t i : indices) {
+    ps.clear();
+    for (jlcxx::cxxint_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+      ps.push_back(Point_2(xy[2 * k], xy[2 * k + 1]));
+    }
+    pls.push_back(ps.begin(), ps.end(), closed);
+  }
+  return pls;
+}
+
+inline void
+check_polylines(jlcxx::ArrayRef<double> xy,
+                jlcxx::ArrayRef<jlcxx::cxxint_t> offsets) {
+  if (xy.size() % 2 != 0) {
+    throw std::invalid_argument("coordinates must come in xy pairs");
+  }
+  if (offsets.size() == 0 || offsets[0] != 0) {
+    throw std::invalid_argument("offsets must start at 0");
+  }
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      throw std::invalid_argument("offsets must be non-decreasing");
+    }
+  }
+  if (static_cast<std::size_t>(offsets[offsets.size() - 1]) > xy.size() / 2) {
+    throw std::out_of_range("offsets exceed the coordinates");
+  }
+}
+
+// Groups polylines into chunks of about `chunk_size` polylines that can be
+// simplified independently without breaking topology: simplification keeps
+// a subset of each polyline's vertices, so that polylines stay within their
+// bounding boxes, and polylines whose boxes meet (those sharing vertices, in
+// particular) go to the same chunk.  A chunk is larger when a connected
+// group of boxes is.  Chunks list their polylines in input order.
+inline std::vector<std::vector<std::size_t>>
+independent_chunks(jlcxx::ArrayRef<double> xy,
+                   jlcxx::ArrayRef<jlcxx::cxxint_t> offsets,
+                   const std::size_t chunk_size) {
+  typedef CGAL::Box_intersection_d::Box_with_info_d<double, 2, std::size_t,
+    CGAL::Box_intersection_d::ID_EXPLICIT> Box;
+
+  const std::size_t n = offsets.size() - 1;
+  std::vector<Box> boxes;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (offsets[i] == offsets[i + 1]) continue;
+    const std::size_t b = offsets[i];
+    Bbox_2 bb(xy[2 * b], xy[2 * b + 1], xy[2 * b], xy[2 * b + 1]);
+    for (jlcxx::cxxint_t k = offsets[i] + 1; k < offsets[i + 1]; ++k) {
+      bb += Bbox_2(xy[2 * k], xy[2 * k + 1], xy[2 * k], xy[2 * k + 1]);
+    }
+    boxes.push_back(Box(bb, i));
+  }
+
+  // Union-find, each group rooted at its first polyline.
+  std::vector<std::size_t> root(n);
+  std::iota(root.begin(), root.end(), 0);
+  auto find = [&root](std::size_t i) {
+    while (root[i] != i) i = root[i] = root[root[i]];
+    return i;
+  };
+  CGAL::box_self_intersection_d(boxes.begin(), boxes.end(),
+                                [&](const Box& a, const Box& b) {
+    const std::size_t ra = find(a.info()), rb = find(b.info());
+    if (ra != rb) root[std::max(ra, rb)] = std::min(ra, rb);
+  });
+  for (std::size_t i = 0; i < n; ++i) root[i] = find(i);
+
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&root](const std::size_t i, const std::size_t j) {
+    return root[i] < root[j];
+  });
+  std::vector<std::vector<std::size_t>> chunks;
+  for (std::size_t k = 0; k < n; ++k) {
+    const bool new_group = k == 0 || root[order[k]] != root[order[k - 1]];
+    if (chunks.empty() || (new_group && chunks.back().size() >= chunk_size)) {
+      chunks.emplace_back();
+    }
+    chunks.back().push_back(order[k]);
+  }
+  for (auto& c : chunks) std::sort(c.begin(), c.end());
+  return chunks;
+}
+
+inline std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>>
+pack_polylines(const std::vector<Polylines_2>& chunks) {
+  jlcxx::Array<double> coords;
+  jlcxx::Array<jlcxx::cxxint_t> offsets;
+  jlcxx::cxxint_t n = 0;
+  offsets.push_back(0);
+  for (const Polylines_2& pls : chunks) {
+    for (const Point_2& p : pls.points) {
+      coords.push_back(CGAL::to_double(p.x()));
+      coords.push_back(CGAL::to_double(p.y()));
+    }
+    for (std::size_t i = 1; i < pls.offsets.size(); ++i) {
+      offsets.push_back(n + pls.offsets[i]);
+    }
+    n += pls.points.size();
+  }
+  return std::make_tuple(coords, offsets);
+}
+
+template<typename InputIterator>
+Polylines_2
+polygon_rings(InputIterator first, InputIterator beyond) {
+  Polylines_2 pls;
+  for (; first != beyond; ++first) {
+    const Polygon_2& outer = first->outer_boundary();
+    pls.push_back(outer.vertices_begin(), outer.vertices_end(), true);
+    for (auto h = first->holes_begin(); h != first->holes_end(); ++h) {
+      pls.push_back(h->vertices_begin(), h->vertices_end(), true);
+    }
+  }
+  return pls;
+}
+
+inline Polygon_2
+polygon_ring(const Polylines_2& pls, const std::size_t i) {
+  return Polygon_2(pls.points.begin() + pls.offsets[i],
+                   pls.points.begin() + pls.offsets[i + 1]);
+}
+
+void wrap_polyline_simplification_2(jlcxx::Module& cgal) {
+  cgal.add_bits<Simplification_stop>("SimplificationStop",
+                                     jlcxx::julia_type("CppEnum"));
+  cgal.set_const("STOP_BELOW_COUNT_RATIO", STOP_BELOW_COUNT_RATIO);
+  cgal.set_const("STOP_BELOW_COUNT",       STOP_BELOW_COUNT);
+  cgal.set_const("STOP_ABOVE_COST",        STOP_ABOVE_COST);
+
+  // Flat polylines (or rings, if closed), simplified together
+  cgal.method("simplify", [](jlcxx::ArrayRef<double> xy,
+                             jlcxx::ArrayRef<jlcxx::cxxint_t> offsets,
+                             const bool closed, const Simplification_stop stop,
+                             const double threshold) {
+    check_polylines(xy, offsets);
+    std::vector<std::size_t> all(offsets.size() - 1);
+    std::iota(all.begin(), all.end(), 0);
+    const std::vector<Polylines_2> res = {
+      simplify(polylines(xy, offsets, closed, all), stop, threshold)
+    };
+    return pack_polylines(res);
+  });
+  // Flat polylines again, for inputs too large for a single triangulation:
+  // they are split into chunks of about `chunk_size` polylines that cannot
+  // interact, see `independent_chunks`, simplified in parallel.  Topology is
+  // preserved as by `simplify`, but the stop criterion applies to each chunk.
+  // All input is held in memory; this is not a streaming mode.
+  cgal.method("simplify_chunks", [](jlcxx::ArrayRef<double> xy,
+                                    jlcxx::ArrayRef<jlcxx::cxxint_t> offsets,
+                                    const bool closed, const Simplification_stop stop,
+                                    const double threshold,
+                                    const jlcxx::cxxint_t chunk_size) {
+    check_polylines(xy, offsets);
+    if (chunk_size < 1) {
+      throw std::invalid_argument("chunk size must be positive");
+    }
+    const std::vector<std::vector<std::size_t>> chunks =
+      independent_chunks(xy, offsets, chunk_size);
+    std::vector<Polylines_2> res(chunks.size());
+    parallel_for(res.size(), [&](const std::size_t k) {
+      res[k] = simplify(polylines(xy, offsets, closed, chunks[k]), stop,
+                        threshold);
+    });
+
+    // back to input order
+    std::vector<std::pair<std::size_t, std::size_t>> where(offsets.size() - 1);
+    for (std::size_t k = 0; k < chunks.size(); ++k) {
+      for (std::size_t j = 0; j < chunks[k].size(); ++j) {
+        where[chunks[k][j]] = std::make_pair(k, j);
+      }
+    }
+    std::vector<Polylines_2> sorted(1);
+    for (const auto& kj : where) {
+      const Polylines_2& pls = res[kj.first];
+      sorted[0].push_back(pls.points.begin() + pls.offsets[kj.second],
+                          pls.points.begin() + pls.offsets[kj.second + 1],
+                          closed);
+    }
+    return pack_polylines(sorted);
+  });
+
+  // Polygons, with their holes, and collections of polygons sharing
+  // boundaries
+  cgal.method("simplify", [](const Polygon_2& p, const Simplification_stop stop,
+                             const double threshold) {
+    Polylines_2 pls;
+    pls.push_back(p.vertices_begin(), p.vertices_end(), true);
+    return polygon_ring(simplify(pls, stop, threshold), 0);
+  });
+  cgal.method("simplify", [](const Polygon_with_holes_2& pwh,
+                             const Simplification_stop stop,
+                             const double threshold) {
+    const Polylines_2 pls = simplify(polygon_rings(&pwh, &pwh + 1), stop,
+                                     threshold);
+    Polygon_with_holes_2 res(polygon_ring(pls, 0));
+    for (std::size_t i = 1; i < pls.size(); ++i) {
+      res.add_hole(polygon_ring(pls, i));
+    }
+    return res;
+  });
+  cgal.method("simplify", [](const Polygon_collection_2& pc,
+                             const Simplification_stop stop,
+                             const double threshold) {
+    const Polylines_2 pls = simplify(polygon_rings(pc.begin(), pc.end()), stop,
+                                     threshold);
+    Polygon_collection_2 res;
+    res.reserve(pc.size());
+    std::size_t r = 0;
+    for (const Polygon_with_holes_2& pwh : pc) {
+      res.push_back(Polygon_with_holes_2(polygon_ring(pls, r++)));
+      for (std::size_t h = 0; h < pwh.number_of_holes(); ++h) {
+        res.back().add_hole(polygon_ring(pls, r++));
+      }
+    }
+    return jlcxx::create<Polygon_collection_2>(std::move(res));
+  });
+}
+
+} // jlcgal
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <CGAL/Parabola_segment_2.h>
+#include <CGAL/Triangulation_utils_2.h>
+
+#include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
+
+#include <julia.h>
+
+#include "kernel.hpp"
+#include "segment_delaunay_graph.hpp"
+#include "utils.hpp"
+#include "voronoi_cells.hpp"
+
+namespace jlcgal {
+
+typedef CGAL::Triangulation_cw_ccw_2 Cw_ccw_2;
+
+// Adds the parabolic arc between point site `p` and segment site `s`, from
+// Voronoi vertex a to b.  With the directrix as the axis, the arc is the
+// graph of h(t) = ((t - tp)^2 + hp^2) / (2 hp), whose chords over steps of
+// w deviate by at most w^2 / (8 hp): steps are chosen to keep that within
+// `tolerance`.
+inline void
+add_parabola(const Sdg_site_2& p, const Sdg_site_2& s, const Sdg_point_2& a,
+             const Sdg_point_2& b, const double tolerance,
+             Polyline_clipper_2& out) {
+  const Sdg_segment_2 seg = s.segment();
+  const double ox = seg.source().x(), oy = seg.source().y();
+  double dx = seg.target().x() - ox, dy = seg.target().y() - oy;
+  const double len = std::hypot(dx, dy);
+  dx /= len;
+  dy /= len;
+  const double fx = p.point().x() - ox, fy = p.point().y() - oy,
+               tp = fx * dx + fy * dy;
+  double nx = -dy, ny = dx, hp = fx * nx + fy * ny;
+  if (hp < 0) {
+    nx = -nx;
+    ny = -ny;
+    hp = -hp;
+  }
+
+  const double ta = (a.x() - ox) * dx + (a.y() - oy) * dy,
+               tb = (b.x() - ox) * dx + (b.y() - oy) * dy;
+  const std::size_t n = hp > 0 ? std::max(1., std::ceil(
+    std::abs(tb - ta) / std::sqrt(8 * hp * tolerance))) : 1;
+  double x = a.x(), y = a.y();
+  for (std::size_t i = 1; i < n; ++i) {
+    const double t = ta + (tb - ta) * i / n,
+                 h = ((t - tp) * (t - tp) + hp * hp) / (2 * hp),
+                 qx = ox + t * dx + h * nx, qy = oy + t * dy + h * ny;
+    out.add(x, y, qx, qy);
+    x = qx;
+    y = qy;
+  }
+  out.add(x, y, b.x(), b.y());
+}
+
+// Bisectors (the Voronoi edges) of the finite edges, clipped to a rectangle:
+// lines, rays and segments as they are, parabolic arcs sampled until within
+// `tolerance` of the curve.
+template<typename SDG>
+std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>>
+bisectors(const SDG& sdg, const Iso_rectangle_2& clip, const double tolerance) {
+  if (!(tolerance > 0)) {
+    throw std::invalid_argument("tolerance must be positive");
+  }
+  const double inf = std::numeric_limits<double>::infinity();
+  Polyline_clipper_2 out(clip);
+  for (auto it = sdg.finite_edges_begin(); it != sdg.finite_edges_end(); ++it) {
+    const CGAL::Object o = sdg.primal(*it);
+    Sdg_line_2 l;
+    Sdg_ray_2 r;
+    Sdg_segment_2 s;
+    CGAL::Parabola_segment_2<Sdg_gt_2> ps;
+    if (CGAL::assign(l, o)) {
+      out.add(l.point(0).x(), l.point(0).y(), l.point(1).x(), l.point(1).y(),
+              -inf, inf);
+    } else if (CGAL::assign(r, o)) {
+      out.add(r.source().x(), r.source().y(), r.point(1).x(), r.point(1).y(),
+              0, inf);
+    } else if (CGAL::assign(s, o)) {
+      out.add(s.source().x(), s.source().y(), s.target().x(), s.target().y());
+    } else if (CGAL::assign(ps, o)) {
+      const auto f = it->first, g = f->neighbor(it->second);
+      const Sdg_site_2 &u = f->vertex(Cw_ccw_2::ccw(it->second))->site(),
+                       &v = f->vertex(Cw_ccw_2::cw(it->second))->site();
+      add_parabola(u.is_point() ? u : v, u.is_point() ? v : u,
+                   sdg.primal(g), sdg.primal(f), tolerance, out);
+    }
+    out.close();
+  }
+  return out.result();
+}
+
+template<typename SDG>
+void
+wrap_segment_delaunay_graph(jlcxx::Module& cgal, const std::string& name) {
+  typedef typename SDG::Edge   Edge;
+  typedef typename SDG::Face   Face;
+  typedef typename SDG::Vertex Vertex;
+
+  auto sdg = cgal.add_type<SDG>(name);
+  cgal.add_type<Edge>(name + "Edge");
+  auto sdgface   = cgal.add_type<Face>  (name + "Face");
+  auto sdgvertex = cgal.add_type<Vertex>(name + "Vertex");
+
+  sdgvertex
+    .method("site", [](const Vertex& v) { return v.site(); })
+    ;
+
+  sdgface
+    .method("vertex", [](const Face& f, const jlcxx::cxxint_t i) {
+      return *f.vertex(i - 1);
+    })
+    .method("neighbor", [](const Face& f, const jlcxx::cxxint_t i) {
+      return *f.neighbor(i - 1);
+    })
+    ;
+
+  sdg
+    // Creation
+    .template constructor<const SDG&>()
+    .method(name, [](jlcxx::ArrayRef<Sdg_site_2> ss) {
+      return jlcxx::create<SDG>(ss.begin(), ss.end());
+    })
+    // Access Functions
+    .method("dimension",              &SDG::dimension)
+    .method("number_of_vertices",     &SDG::number_of_vertices)
+    .method("number_of_faces",        &SDG::number_of_faces)
+    .method("number_of_input_sites",  &SDG::number_of_input_sites)
+    .method("number_of_output_sites", &SDG::number_of_output_sites)
+    // Insertion, of packed xy points and x1, y1, x2, y2 segments: points
+    // first, spatially sorted, then segments in random order.
+    .method("insert_sites!", [](SDG& sdg, jlcxx::ArrayRef<double> xy,
+                                jlcxx::ArrayRef<double> segments) -> SDG& {
+      if (xy.size() % 2 != 0 || segments.size() % 4 != 0) {
+        throw std::invalid_argument("coordinates do not make whole sites");
+      }
+      std::vector<Sdg_site_2> sites;
+      sites.reserve(xy.size() / 2 + segments.size() / 4);
+      for (std::size_t i = 0; i < xy.size(); i += 2) {
+        sites.push_back(Sdg_site_2::construct_site_2(
+          Sdg_point_2(xy[i], xy[i + 1])));
+      }
+      for (std::size_t i = 0; i < segments.size(); i += 4) {
+        sites.push_back(Sdg_site_2::construct_site_2(
+          Sdg_point_2(segments[i],     segments[i + 1]),
+          Sdg_point_2(segments[i + 2], segments[i + 3])));
+      }
+      sdg.insert(sites.begin(), sites.end(), CGAL::Tag_true());
+      return sdg;
+    })
+    // Flat Export, as polylines with CSR offsets counting points
+    .method("bisectors", &bisectors<SDG>)
+    // Validity Check
+    .method("is_valid", [](const SDG& sdg) { return sdg.is_valid(); })
+    ;
+  cgal.set_override_module(jl_base_module);
+  sdg
+    // Insertion
+    .method("push!", [](SDG& sdg, const Sdg_site_2& s) -> SDG& {
+      sdg.insert(s);
+      return sdg;
+    })
+    .method("insert!", [](SDG& sdg, jlcxx::ArrayRef<Sdg_site_2> ss) -> SDG& {
+      sdg.insert(ss.begin(), ss.end());
+      return sdg;
+    })
+    .method("empty!", [](SDG& sdg) -> SDG& {
+      sdg.clear();
+      return sdg;
+    })
+    ;
+  cgal.unset_override_module();
+}
+
+void wrap_segment_delaunay_graph_2(jlcxx::Module& cgal) {
+  typedef Sdg_site_2 Site_2;
+
+  // Sites are points or segments, possibly subsegments of intersecting
+  // input segments; coordinates are rounded to doubles.
+  const std::string site_name = "SegmentDelaunayGraphSite2";
+  cgal.add_type<Site_2>(site_name)
+    .method("is_point",   &Site_2::is_point)
+    .method("is_segment", &Site_2::is_segment)
+    .method("is_input",   [](const Site_2& s) { return s.is_input(); })
+    .method("point", [](const Site_2& s) {
+      if (!s.is_point()) throw std::invalid_argument("site is not a point");
+      return To_linear<Sdg_point_2>()(s.point());
+    })
+    .method("segment", [](const Site_2& s) {
+      if (!s.is_segment()) throw std::invalid_argument("site is not a segment");
+      return To_linear<Sdg_segment_2>()(s.segment());
+    })
+    ;
+  cgal.method(site_name, [](const Point_2& p) {
+    return Site_2::construct_site_2(To_sdg<Sdg_point_2>()(p));
+  });
+  cgal.method(site_name, [](const Point_2& p, const Point_2& q) {
+    To_sdg<Sdg_point_2> p2s;
+    return Site_2::construct_site_2(p2s(p), p2s(q));
+  });
+
+  wrap_segment_delaunay_graph<SDG_2> (cgal, "SegmentDelaunayGraph2");
+  wrap_segment_delaunay_graph<SDGH_2>(cgal, "SegmentDelaunayGraphHierarchy2");
+}
+
+} // jlcgal
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <CGAL/Triangulation_face_base_with_info_2.h>
+
+#include <jlcxx/module.hpp>
+
+#include <julia.h>
+
+#include "triangulation.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+struct Stream_vertex_info {
+  std::size_t id = 0;
+  bool retired = false; // all incident faces were emitted
+};
+
+struct Stream_face_info {
+  bool emitted = false; // emitted, or left over from removing a vertex
+};
+
+typedef CGAL::Triangulation_vertex_base_with_info_2<Stream_vertex_info, Kernel> Stream_vb_2;
+typedef CGAL::Triangulation_face_base_with_info_2<Stream_face_info, Kernel>     Stream_fb_2;
+typedef CGAL::Triangulation_data_structure_2<Stream_vb_2, Stream_fb_2>          Stream_tds_2;
+typedef CGAL::Delaunay_triangulation_2<Kernel, Stream_tds_2>                    Stream_DTr_2;
+
+// Delaunay triangulation of a point stream over a rectangular domain split
+// in an nx by ny grid of cells.  Once a cell is finalized, no more points
+// may fall in it, so faces whose circumcircles only cover finalized cells
+// (or lie outside of the domain) can no longer change: they are emitted to a
+// buffer.  Vertices whose faces were all emitted are removed, provided that
+// the faces filling the hole also lie in finalized space, which keeps the
+// triangulation outside finalized space identical to the one of the whole
+// stream and memory proportional to the active front.
+class Streaming_delaunay_2 {
+public:
+  Streaming_delaunay_2(const Iso_rectangle_2& domain, const jlcxx::cxxint_t nx,
+                       const jlcxx::cxxint_t ny)
+    : _domain(domain), _nx(nx), _ny(ny),
+      _xmin(CGAL::to_double(domain.xmin())), _xmax(CGAL::to_double(domain.xmax())),
+      _ymin(CGAL::to_double(domain.ymin())), _ymax(CGAL::to_double(domain.ymax())) {
+    if (nx < 1 || ny < 1) {
+      throw std::invalid_argument("there must be at least one cell");
+    }
+    if (domain.is_degenerate()) {
+      throw std::invalid_argument("domain must not be degenerate");
+    }
+    _finalized.assign(_nx * _ny, false);
+  }
+
+  std::size_t number_of_vertices() const { return _dt.number_of_vertices(); }
+  std::size_t number_of_points()   const { return _next_id; }
+
+  // Inserts packed xy coordinates; the points get consecutive ids, following
+  // the ones of previously inserted points.  A duplicate keeps the vertex of
+  // the first occurrence, so its own id never shows up in triangles.
+  void insert(jlcxx::ArrayRef<double> xy) {
+    if (xy.size() % 2 != 0) {
+      throw std::invalid_argument("coordinates must come in xy pairs");
+    }
+    std::vector<Point_2> ps;
+    ps.reserve(xy.size() / 2);
+    for (std::size_t i = 0; i < xy.size(); i += 2) {
+      ps.emplace_back(xy[i], xy[i + 1]);
+      if (_domain.has_on_unbounded_side(ps.back())) {
+        throw std::invalid_argument("point outside of the domain");
+      }
+      if (_finalized[cell(CGAL::to_double(ps.back().x()),
+                          CGAL::to_double(ps.back().y()))]) {
+        throw std::invalid_argument("point in a finalized cell");
+      }
+    }
+
+    Stream_DTr_2::Face_handle hint;
+    for (const Point_2& p : ps) {
+      const std::size_t n = _dt.number_of_vertices();
+      Stream_DTr_2::Vertex_handle v = _dt.insert(p, hint);
+      if (_dt.number_of_vertices() > n) v->info().id = _next_id;
+      ++_next_id;
+      hint = v->face();
+    }
+  }
+
+  // Finalizes the given 1-based cells, emitting the faces that became final.
+  void finalize(jlcxx::ArrayRef<jlcxx::cxxint_t> cells) {
+    for (jlcxx::cxxint_t c : cells) {
+      if (c < 1 || static_cast<std::size_t>(c) > _finalized.size()) {
+        throw std::out_of_range("cell index out of range");
+      }
+      _finalized[c - 1] = true;
+    }
+    if (_dt.dimension() < 2) return;
+
+    for (auto it = _dt.finite_faces_begin(); it != _dt.finite_faces_end(); ++it) {
+      if (!it->info().emitted && is_final(it)) emit(it);
+    }
+    std::vector<Stream_DTr_2::Vertex_handle> retired;
+    for (auto it = _dt.finite_vertices_begin(); it != _dt.finite_vertices_end(); ++it) {
+      if (it->info().retired || is_retired(it)) {
+        it->info().retired = true;
+        retired.push_back(it);
+      }
+    }
+    for (Stream_DTr_2::Vertex_handle v : retired) release(v);
+  }
+
+  // Ends the stream, emitting every face left.
+  void finish() {
+    std::fill(_finalized.begin(), _finalized.end(), true);
+    for (auto it = _dt.finite_faces_begin(); it != _dt.finite_faces_end(); ++it) {
+      if (!it->info().emitted) emit(it);
+    }
+    _dt.clear();
+  }
+
+  // Emitted triangles as triples of 1-based point ids, since the last call.
+  std::vector<std::size_t> take_triangles() {
+    std::vector<std::size_t> res;
+    res.swap(_triangles);
+    return res;
+  }
+
+private:
+  static std::size_t slot(const double v, const double lo, const double hi,
+                          const std::size_t n) {
+    const double t = (v - lo) / (hi - lo) * n;
+    return static_cast<std::size_t>(std::min<double>(n - 1, std::max(0.0, t)));
+  }
+
+  std::size_t column(const double x) const { return slot(x, _xmin, _xmax, _nx); }
+  std::size_t row   (const double y) const { return slot(y, _ymin, _ymax, _ny); }
+
+  std::size_t cell(const double x, const double y) const {
+    return row(y) * _nx + column(x);
+  }
+
+  // Circumcircles are tested on their bounding boxes, which contain them.
+  bool is_final(const Stream_DTr_2::Face_handle f) const {
+    const Bbox_2 bb = circumcircle_bbox(f);
+    const std::size_t i0 = column(bb.xmin()), i1 = column(bb.xmax()),
+                      j0 = row(bb.ymin()),    j1 = row(bb.ymax());
+    for (std::size_t j = j0; j <= j1; ++j) {
+      for (std::size_t i = i0; i <= i1; ++i) {
+        if (!_finalized[j * _nx + i]) return false;
+      }
+    }
+    return true;
+  }
+
+  bool is_retired(const Stream_DTr_2::Vertex_handle v) const {
+    auto fc = _dt.incident_faces(v), done = fc;
+    do {
+      if (_dt.is_infinite(fc) || !fc->info().emitted) return false;
+    } while (++fc != done);
+    return true;
+  }
+
+  void emit(const Stream_DTr_2::Face_handle f) {
+    f->info().emitted = true;
+    for (int i = 0; i < 3; ++i) _triangles.push_back(f->vertex(i)->info().id + 1);
+  }
+
+  // Removes a retired vertex, putting it back if a face filling the hole
+  // could still be invalidated by future points.
+  void release(const Stream_DTr_2::Vertex_handle v) {
+    if (_dt.number_of_vertices() <= 3) return;
+
+    const Point_2 p = v->point();
+    const Stream_vertex_info info = v->info();
+    std::vector<Stream_DTr_2::Vertex_handle> ring;
+    auto vc = _dt.incident_vertices(v), done = vc;
+    do { ring.push_back(vc); } while (++vc != done);
+
+    // faces around the ring that survive the removal
+    std::unordered_set<Stream_DTr_2::Face_handle,
+                       CGAL::Handle_hash_function> kept;
+    for (auto u : ring) {
+      auto fc = _dt.incident_faces(u), fdone = fc;
+      do {
+        if (!fc->has_vertex(v)) kept.insert(fc);
+      } while (++fc != fdone);
+    }
+
+    _dt.remove(v);
+
+    bool safe = _dt.dimension() == 2;
+    std::vector<Stream_DTr_2::Face_handle> hole;
+    for (auto u : ring) {
+      if (!safe) break;
+      auto fc = _dt.incident_faces(u), fdone = fc;
+      do {
+        if (!kept.count(fc)) {
+          hole.push_back(fc);
+          kept.insert(fc);
+        }
+      } while (++fc != fdone);
+    }
+
+    for (auto f : hole) {
+      if (_dt.is_infinite(f) || !is_final(f)) safe = false;
+    }
+    if (safe) {
+      for (auto f : hole) f->info().emitted = true;
+      return;
+    }
+
+    Stream_DTr_2::Vertex_handle w = _dt.insert(p, ring.front()->face());
+    w->info() = info;
+    if (_dt.dimension() < 2) return;
+    auto fc = _dt.incident_faces(w), fdone = fc;
+    do { fc->info().emitted = true; } while (++fc != fdone);
+  }
+
+  Iso_rectangle_2 _domain;
+  std::size_t _nx, _ny;
+  double _xmin, _xmax, _ymin, _ymax;
+  std::vector<bool> _finalized;
+  Stream_DTr_2 _dt;
+  std::size_t _next_id = 0;
+  std::vector<std::size_t> _triangles;
+};
+
+void wrap_streaming_delaunay_2(jlcxx::Module& cgal) {
+  typedef Streaming_delaunay_2 SDTr_2;
+  const std::string sdtr_name = "StreamingDelaunayTriangulation2";
+
+  auto sdtr = cgal.add_type<SDTr_2>(sdtr_name)
+    // Creation
+    .constructor<const Iso_rectangle_2&, jlcxx::cxxint_t, jlcxx::cxxint_t>()
+    // Access Functions
+    .method("number_of_vertices", &SDTr_2::number_of_vertices)
+    .method("number_of_points",   &SDTr_2::number_of_points)
+    // Streaming
+    .method("finalize!", [](SDTr_2& st, jlcxx::ArrayRef<jlcxx::cxxint_t> cells)
+                           -> SDTr_2& {
+      st.finalize(cells);
+      return st;
+    })
+    .method("finish!", [](SDTr_2& st) -> SDTr_2& {
+      st.finish();
+      return st;
+    })
+    .method("take_triangles!", [](SDTr_2& st) {
+      const std::vector<std::size_t> ts = st.take_triangles();
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (std::size_t v : ts) jlarr.push_back(v);
+      return jlarr;
+    })
+    ;
+  cgal.set_override_module(jl_base_module);
+  sdtr
+    .method("insert!", [](SDTr_2& st, jlcxx::ArrayRef<double> xy) -> SDTr_2& {
+      st.insert(xy);
+      return st;
+    })
+    ;
+  cgal.unset_override_module();
+}
+
+} // jlcgal
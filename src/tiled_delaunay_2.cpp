@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <jlcxx/module.hpp>
+
+#include "parallel.hpp"
+#include "triangulation.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+typedef std::pair<Point_2, std::size_t> Indexed_point_2;
+
+// Splits the bounding box of the input into an nx by ny grid of tiles.  Grid
+// lines are computed once, so that assigning a point to a tile and testing
+// against the tile's bounds agree exactly: tile (i, j) holds the points with
+// xs[i] <= x < xs[i+1] and ys[j] <= y < ys[j+1], the last row and column
+// being closed.
+class Tile_grid_2 {
+public:
+  Tile_grid_2(jlcxx::ArrayRef<double> xy, const std::size_t nx,
+              const std::size_t ny)
+    : _xs(nx + 1), _ys(ny + 1) {
+    double xmin = xy[0], xmax = xy[0], ymin = xy[1], ymax = xy[1];
+    for (std::size_t i = 0; i < xy.size(); i += 2) {
+      xmin = std::min(xmin, xy[i]);     xmax = std::max(xmax, xy[i]);
+      ymin = std::min(ymin, xy[i + 1]); ymax = std::max(ymax, xy[i + 1]);
+    }
+    for (std::size_t i = 0; i < nx; ++i) _xs[i] = xmin + i * (xmax - xmin) / nx;
+    for (std::size_t j = 0; j < ny; ++j) _ys[j] = ymin + j * (ymax - ymin) / ny;
+    _xs[nx] = xmax;
+    _ys[ny] = ymax;
+  }
+
+  std::size_t nx()   const { return _xs.size() - 1; }
+  std::size_t ny()   const { return _ys.size() - 1; }
+  std::size_t size() const { return nx() * ny(); }
+
+  std::size_t column(const double x) const { return slot(_xs, x); }
+  std::size_t row   (const double y) const { return slot(_ys, y); }
+  std::size_t tile(const double x, const double y) const {
+    return row(y) * nx() + column(x);
+  }
+
+  // Whether the bounding box lies in the interior of tile t.
+  bool strictly_inside(const Bbox_2& bb, const std::size_t t) const {
+    const std::size_t i = t % nx(), j = t / nx();
+    return _xs[i] < bb.xmin() && bb.xmax() < _xs[i + 1] &&
+           _ys[j] < bb.ymin() && bb.ymax() < _ys[j + 1];
+  }
+
+private:
+  static std::size_t slot(const std::vector<double>& ls, const double v) {
+    auto it = std::upper_bound(ls.begin() + 1, ls.end() - 1, v);
+    return it - ls.begin() - 1;
+  }
+
+  std::vector<double> _xs, _ys;
+};
+
+// Triangulates the point set tile by tile, in parallel.  A face whose
+// circumcircle lies in the interior of its tile cannot be invalidated by
+// points from other tiles, so it is final.  Every other Delaunay face has
+// its vertices among the vertices of non-final or hull faces of their tiles,
+// which are triangulated once more; of the stitched faces, those with an
+// empty circumcircle that no tile owns complete the triangulation.
+// Returns the triangles as triples of 1-based indices into the input.
+jlcxx::Array<jlcxx::cxxint_t>
+tiled_delaunay(jlcxx::ArrayRef<double> xy, const jlcxx::cxxint_t nx,
+               const jlcxx::cxxint_t ny) {
+  if (nx < 1 || ny < 1) {
+    throw std::invalid_argument("there must be at least one tile");
+  }
+  if (xy.size() % 2 != 0) {
+    throw std::invalid_argument("coordinates must come in xy pairs");
+  }
+  jlcxx::Array<jlcxx::cxxint_t> jlarr;
+  if (xy.size() == 0) return jlarr;
+
+  const Tile_grid_2 grid(xy, nx, ny);
+  std::vector<std::vector<Indexed_point_2>> tile_points(grid.size());
+  for (std::size_t i = 0; i < xy.size() / 2; ++i) {
+    tile_points[grid.tile(xy[2 * i], xy[2 * i + 1])].emplace_back(
+      Point_2(xy[2 * i], xy[2 * i + 1]), i);
+  }
+
+  std::vector<Indexed_DTr_2> tiles(grid.size());
+  std::vector<std::vector<std::size_t>> final_faces(grid.size());
+  std::vector<std::vector<Indexed_point_2>> seams(grid.size());
+  parallel_for(grid.size(), [&](const std::size_t t) {
+    Indexed_DTr_2& dt = tiles[t];
+    dt.insert(tile_points[t].begin(), tile_points[t].end());
+    tile_points[t] = std::vector<Indexed_point_2>();
+
+    if (dt.dimension() < 2) {
+      for (auto it = dt.finite_vertices_begin(); it != dt.finite_vertices_end(); ++it) {
+        seams[t].emplace_back(it->point(), it->info());
+      }
+      return;
+    }
+
+    std::unordered_set<Indexed_DTr_2::Vertex_handle,
+                       CGAL::Handle_hash_function> on_seam;
+    for (auto it = dt.all_faces_begin(); it != dt.all_faces_end(); ++it) {
+      const bool is_final = !dt.is_infinite(it) &&
+                            grid.strictly_inside(circumcircle_bbox(it), t);
+      for (int i = 0; i < 3; ++i) {
+        if (is_final) {
+          final_faces[t].push_back(it->vertex(i)->info());
+        } else if (!dt.is_infinite(it->vertex(i))) {
+          on_seam.insert(it->vertex(i));
+        }
+      }
+    }
+    for (const auto& v : on_seam) {
+      seams[t].emplace_back(v->point(), v->info());
+    }
+  });
+
+  std::vector<Indexed_point_2> seam;
+  for (auto& s : seams) {
+    seam.insert(seam.end(), s.begin(), s.end());
+    s = std::vector<Indexed_point_2>();
+  }
+  Indexed_DTr_2 stitch;
+  stitch.insert(seam.begin(), seam.end());
+
+  std::vector<Indexed_DTr_2::Face_handle> candidates;
+  for (auto it = stitch.finite_faces_begin(); it != stitch.finite_faces_end(); ++it) {
+    candidates.push_back(it);
+  }
+  std::vector<char> keep(candidates.size(), 0);
+  parallel_for(candidates.size(), [&](const std::size_t k) {
+    const Indexed_DTr_2::Face_handle f = candidates[k];
+    const Point_2 &p = f->vertex(0)->point(),
+                  &q = f->vertex(1)->point(),
+                  &r = f->vertex(2)->point();
+    const Bbox_2 bb = circumcircle_bbox(f);
+    const std::size_t i0 = grid.column(bb.xmin()), i1 = grid.column(bb.xmax()),
+                      j0 = grid.row(bb.ymin()),    j1 = grid.row(bb.ymax());
+    const Point_2 c = CGAL::circumcenter(p, q, r);
+    for (std::size_t j = j0; j <= j1; ++j) {
+      for (std::size_t i = i0; i <= i1; ++i) {
+        const std::size_t t = j * grid.nx() + i;
+        if (grid.strictly_inside(bb, t)) return;
+        if (tiles[t].number_of_vertices() == 0) continue;
+        const Point_2& s = tiles[t].nearest_vertex(c)->point();
+        if (CGAL::side_of_bounded_circle(p, q, r, s) == CGAL::ON_BOUNDED_SIDE) {
+          return;
+        }
+      }
+    }
+    keep[k] = 1;
+  });
+
+  for (const auto& ff : final_faces) {
+    for (std::size_t v : ff) jlarr.push_back(v + 1);
+  }
+  for (std::size_t k = 0; k < candidates.size(); ++k) {
+    if (!keep[k]) continue;
+    for (int i = 0; i < 3; ++i) {
+      jlarr.push_back(candidates[k]->vertex(i)->info() + 1);
+    }
+  }
+  return jlarr;
+}
+
+void wrap_tiled_delaunay_2(jlcxx::Module& cgal) {
+  cgal.method("tiled_delaunay", &tiled_delaunay);
+}
+
+} // jlcgal
@@ -1,9 +1,35 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
 
 #include <julia.h>
 
 #include "utils.hpp"
 #include "triangulation.hpp"
+#include "triangulation_io.hpp"
+
+#define WRAP_TRIANGULATION_VERTEX(V) \
+     method("degree", &V::degree) \
+    .method("point", [](const V& v) -> const V::Point& { \
+      return v.point(); \
+    })
+
+#define WRAP_TRIANGULATION_FACE(F) \
+     method("dimension", &F::dimension) \
+    .method("is_valid", &F::is_valid) \
+    .method("neighbor", [](const F& f, const jlcxx::cxxint_t i) { \
+      return *f.neighbor(i - 1); \
+    }) \
+    .method("vertex", [](const F& f, const jlcxx::cxxint_t i) { \
+      return *f.vertex(i - 1); \
+    })
 
 #define WRAP_TRIANGULATION(T, JT) \
     /* Creation */ \
@@ -77,7 +103,35 @@
     /* Miscellaneous */ \
     .method("segment", [](const T& t, const T::Edge& e) { return t.segment(e); }) \
     /* Checking */ \
-    .method("is_valid", &T::is_valid)
+    .method("is_valid", &T::is_valid) \
+    /* Memory */ \
+    .method("memory_usage", &memory_usage<T>) \
+    .method("reserve!", &reserve<T>) \
+    .method("shrink_to_fit!", &shrink_to_fit<T>) \
+    /* I/O */ \
+    .method("save", &save_binary<T>) \
+    .method("load!", &load_binary<T>)
+
+// Shared by Delaunay triangulations and their hierarchies.
+#define WRAP_DELAUNAY_TRIANGULATION(DT) \
+    /* Vertex Displacement, others going through a `vertex_table` */ \
+     method("move_all!", &move_all<DT>) \
+    /* Queries */ \
+    .method("nearest_vertex", [](const DT& dt, const DT::Point& p) { \
+      return *dt.nearest_vertex(p); \
+    }) \
+    /* Voronoi Diagram */ \
+    .method("dual", [](const DT& dt, const DT::Edge& e) { \
+      auto&& o = dt.dual(e); \
+      if (const Line_2* l = CGAL::object_cast<Line_2>(&o)) { \
+        return (jl_value_t*)jlcxx::box<Line_2>(*l); \
+      } else if (const Ray_2* r = CGAL::object_cast<Ray_2>(&o)) { \
+        return (jl_value_t*)jlcxx::box<Ray_2>(*r); \
+      } else if (const Segment_2* s = CGAL::object_cast<Segment_2>(&o)) { \
+        return (jl_value_t*)jlcxx::box<Segment_2>(*s); \
+      } \
+      return jl_nothing; /* unreachable */ \
+    })
 
 namespace jlcxx {
   using namespace jlcgal;
@@ -93,10 +147,299 @@ namespace jlcxx {
   template<> struct SuperType<RTr_2::Edge>   { typedef RTr_2::Triangulation_base::Edge type; };
   template<> struct SuperType<RTr_2::Face>   { typedef RTr_2::Triangulation_base::Face type; };
   template<> struct SuperType<RTr_2::Vertex> { typedef RTr_2::Triangulation_base::Vertex type; };
+
+  template<> struct SuperType<DHTr_2::Edge>   { typedef DHTr_2::Triangulation::Edge type; };
+  template<> struct SuperType<DHTr_2::Face>   { typedef DHTr_2::Triangulation::Face type; };
+  template<> struct SuperType<DHTr_2::Vertex> { typedef DHTr_2::Triangulation::Vertex type; };
+
+  template<> struct SuperType<CDHTr_2::Edge>   { typedef CDHTr_2::Triangulation::Edge type; };
+  template<> struct SuperType<CDHTr_2::Face>   { typedef CDHTr_2::Triangulation::Face type; };
+  template<> struct SuperType<CDHTr_2::Vertex> { typedef CDHTr_2::Triangulation::Vertex type; };
+
+  template<> struct SuperType<DHTr_2>  { typedef DHTr_2::Triangulation type; };
+  template<> struct SuperType<CDHTr_2> { typedef CDHTr_2::Triangulation type; };
 }
 
 namespace jlcgal {
 
+// Fraction of moved vertices above which relocating them one by one is
+// expected to cost more than rebuilding the triangulation.
+const double MOVE_ALL_REBUILD_FRACTION = 0.5;
+
+// Vertex handles by 1-based index, in the finite vertex order (the order of
+// `points`) as of the table's creation, for constant time access.  Removals
+// and moves through the table keep the other indices valid: a removed
+// vertex leaves a hole, and a moved vertex keeps its handle.  Vertices
+// inserted afterwards have no index; removing vertices other than through
+// the table (`empty!`, `load!`, a rebuilding `move_all!`) invalidates it.
+// The triangulation must outlive the table.
+template<typename DT>
+class Vertex_table {
+public:
+  typedef typename DT::Vertex_handle Vertex_handle;
+  typedef typename DT::Point         Point;
+
+  Vertex_table(DT& dt) : _dt(&dt), _vhs(vertex_handles(dt)) {}
+
+  std::size_t size() const { return _vhs.size(); }
+
+  Vertex_handle at(const jlcxx::cxxint_t i) const {
+    if (i < 1 || static_cast<std::size_t>(i) > _vhs.size()) {
+      throw std::out_of_range("vertex index out of range");
+    }
+    if (_vhs[i - 1] == nullptr) throw std::invalid_argument("vertex was removed");
+    return _vhs[i - 1];
+  }
+
+  void remove(const jlcxx::cxxint_t i) {
+    _dt->remove(at(i));
+    _vhs[i - 1] = Vertex_handle();
+  }
+
+  // Moving a vertex onto another one would merge them: that is refused,
+  // leaving the triangulation as it was.
+  bool move_if_no_collision(const jlcxx::cxxint_t i, const Point& p) {
+    const Vertex_handle vh = at(i);
+    return _dt->move_if_no_collision(vh, p) == vh;
+  }
+
+  void move(const jlcxx::cxxint_t i, const Point& p) {
+    if (!move_if_no_collision(i, p)) {
+      throw std::invalid_argument("another vertex lies at the target point");
+    }
+  }
+
+private:
+  DT* _dt;
+  std::vector<Vertex_handle> _vhs;
+};
+
+// Relocates every vertex, keeping vertex indices stable.  Points must be
+// distinct, since coinciding vertices would be merged.
+template<typename DT>
+DT&
+move_all(DT& dt, jlcxx::ArrayRef<typename DT::Point> ps) {
+  if (ps.size() != dt.number_of_vertices()) {
+    throw std::invalid_argument("#points != #vertices");
+  }
+  std::vector<typename DT::Point> qs(ps.begin(), ps.end());
+  {
+    std::vector<typename DT::Point> sorted(qs);
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+      throw std::invalid_argument("points must be distinct");
+    }
+  }
+
+  std::vector<typename DT::Vertex_handle> vhs = vertex_handles(dt);
+  std::vector<std::size_t> pending;
+  for (std::size_t i = 0; i < vhs.size(); ++i) {
+    if (vhs[i]->point() != qs[i]) pending.push_back(i);
+  }
+
+  // Moves keep vertex handles, hence indices.  A vertex may be blocked by
+  // one still sitting at its target, so blocked moves are retried until
+  // none succeeds (a cycle of swapped positions).
+  if (pending.size() <= MOVE_ALL_REBUILD_FRACTION * vhs.size()) {
+    while (!pending.empty()) {
+      std::vector<std::size_t> blocked;
+      for (const std::size_t i : pending) {
+        if (dt.move_if_no_collision(vhs[i], qs[i]) != vhs[i]) blocked.push_back(i);
+      }
+      if (blocked.size() == pending.size()) break;
+      pending.swap(blocked);
+    }
+    if (pending.empty()) return dt;
+  }
+
+  // Rebuilding, reinserting in index order so that vertex indices stay
+  // stable.  Each insertion is hinted with the previous vertex, which only
+  // keeps walks short if consecutive vertices are close (as after a bulk
+  // construction, which inserts spatially sorted).
+  dt.clear();
+  typename DT::Face_handle hint;
+  for (const typename DT::Point& q : qs) {
+    hint = dt.insert(q, hint)->face();
+  }
+  return dt;
+}
+
+template<typename DT>
+void
+wrap_vertex_table(jlcxx::Module& cgal, const std::string& name) {
+  typedef Vertex_table<DT> Table;
+
+  auto table = cgal.add_type<Table>(name + "VertexTable");
+  cgal.set_override_module(jl_base_module);
+  table
+    .method("length", &Table::size)
+    .method("getindex", [](const Table& vt, const jlcxx::cxxint_t i) {
+      return *vt.at(i);
+    })
+    ;
+  cgal.unset_override_module();
+  table
+    // Vertex Removal and Displacement
+    .method("remove!", [](Table& vt, const jlcxx::cxxint_t i) -> Table& {
+      vt.remove(i);
+      return vt;
+    })
+    .method("move!", [](Table& vt, const jlcxx::cxxint_t i,
+                                   const typename DT::Point& p) -> Table& {
+      vt.move(i, p);
+      return vt;
+    })
+    .method("move_if_no_collision!", &Table::move_if_no_collision)
+    ;
+  cgal.method("vertex_table", [](DT& dt) { return Table(dt); });
+}
+
+// Bytes per vertex and per face, the capacities of the vertex and face
+// containers, and the total number of bytes they hold.  Vertices and faces
+// live in blocks that only grow, so capacities stay at their high-water mark
+// until `shrink_to_fit!`.  Hierarchies report their bottom level only.
+template<typename T>
+std::tuple<std::size_t, std::size_t, std::size_t, std::size_t, std::size_t>
+memory_usage(const T& t) {
+  const std::size_t vbytes = sizeof(typename T::Vertex),
+                    fbytes = sizeof(typename T::Face),
+                    vcap   = t.tds().vertices().capacity(),
+                    fcap   = t.tds().faces().capacity();
+  return std::make_tuple(vbytes, fbytes, vcap, fcap,
+                         vbytes * vcap + fbytes * fcap);
+}
+
+// Reserves room for nv vertices and nf faces ahead of a bulk build; a planar
+// triangulation of n points has fewer than 2n faces.
+template<typename T>
+T&
+reserve(T& t, const jlcxx::cxxint_t nv, const jlcxx::cxxint_t nf) {
+  if (nv < 0 || nf < 0) {
+    throw std::invalid_argument("capacities must be non-negative");
+  }
+  t.tds().vertices().reserve(nv);
+  t.tds().faces().reserve(nf);
+  return t;
+}
+
+// Releases unused capacity by copying into fresh containers, which
+// invalidates all handles.
+template<typename T>
+T&
+shrink_to_fit(T& t) {
+  T copy(t);
+  t.swap(copy);
+  return t;
+}
+
+// Lazily walks the faces crossed by segment pq, from the face containing p up
+// to the one containing q: a single face if p == q.  Finite faces are only
+// visited while they meet the segment, so that a walk starting outside the
+// convex hull stops at q even if the line goes on through the hull.  Once
+// the walk leaves the convex hull, it stops after the first infinite face.
+// The walker keeps a pointer to the triangulation, which must outlive it and
+// must not be modified while walking.
+template<typename T>
+class Segment_walker {
+public:
+  typedef typename T::Face_handle Face_handle;
+  typedef typename T::Point       Point;
+
+  Segment_walker(const T& t, const Point& p, const Point& q)
+    : _t(&t), _pq(bare_point(p), bare_point(q)), _seen_finite(false),
+      _done(false) {
+    if (t.dimension() != 2) {
+      throw std::invalid_argument("triangulation is not 2-dimensional");
+    }
+    if (p == q) {
+      _single = t.locate(p);
+      _done = _single == nullptr;
+      return;
+    }
+    _lfc = t.line_walk(p, q);
+    _done = _lfc == nullptr;
+  }
+
+  Face_handle next() {
+    if (_done) return Face_handle();
+    if (_single != nullptr) {
+      _done = true;
+      return _single;
+    }
+
+    Face_handle fh = _lfc;
+    if (_t->is_infinite(fh)) {
+      _done = _seen_finite;
+    } else {
+      const Triangle_2 tr(bare_point(fh->vertex(0)->point()),
+                          bare_point(fh->vertex(1)->point()),
+                          bare_point(fh->vertex(2)->point()));
+      if (!CGAL::do_intersect(tr, _pq)) {
+        _done = true;
+        return Face_handle();
+      }
+      _seen_finite = true;
+      _done = tr.bounded_side(_pq.target()) != CGAL::ON_UNBOUNDED_SIDE;
+    }
+    ++_lfc;
+    return fh;
+  }
+
+private:
+  const T* _t;
+  Segment_2 _pq;
+  typename T::Line_face_circulator _lfc;
+  Face_handle _single;
+  bool _seen_finite;
+  bool _done;
+};
+
+template<typename T>
+std::tuple<jlcxx::Array<jlcxx::cxxint_t>, jlcxx::Array<jlcxx::cxxint_t>>
+segment_walks(const T& t, jlcxx::ArrayRef<typename T::Point> ps,
+                          jlcxx::ArrayRef<typename T::Point> qs) {
+  if (ps.size() != qs.size()) {
+    throw std::invalid_argument("#sources != #targets");
+  }
+
+  auto fidx = all_face_indices(t);
+  std::vector<jlcxx::cxxint_t> offsets(1, 0), faces;
+  for (std::size_t i = 0; i < ps.size(); ++i) {
+    Segment_walker<T> walker(t, ps[i], qs[i]);
+    for (auto fh = walker.next(); fh != nullptr; fh = walker.next()) {
+      faces.push_back(fidx[fh] + 1);
+    }
+    offsets.push_back(faces.size());
+  }
+
+  return std::make_tuple(collect(offsets.begin(), offsets.end()),
+                         collect(faces.begin(), faces.end()));
+}
+
+template<typename T>
+void
+wrap_segment_walker(jlcxx::Module& cgal, const std::string& name) {
+  typedef Segment_walker<T> Walker;
+
+  cgal.add_type<Walker>(name + "SegmentWalker")
+    .method("next_face!", [](Walker& w) {
+      typename T::Face_handle fh = w.next();
+      return fh != nullptr ?
+        (jl_value_t*)jlcxx::box<typename T::Face>(*fh) :
+        jl_nothing;
+    })
+    ;
+  // The walker refers to the triangulation without keeping it alive: callers
+  // must hold on to the triangulation for as long as they walk.
+  cgal.method("segment_walk", [](const T& t, const typename T::Point& p,
+                                             const typename T::Point& q) {
+    return Walker(t, p, q);
+  });
+  // Batch mode, returning CSR face lists: the faces crossed by the i-th
+  // segment are indices `offsets[i]+1:offsets[i+1]` into `all_faces`.
+  cgal.method("segment_walks", &segment_walks<T>);
+}
+
 void wrap_triangulation_2(jlcxx::Module& cgal) {
   const std::string tr_name = "Triangulation2";
   auto tr      = cgal.add_type<Tr_2>        (tr_name);
@@ -123,23 +466,31 @@ void wrap_triangulation_2(jlcxx::Module& cgal) {
   auto rtface   = cgal.add_type<RTr_2::Face>  (rtr_name + "Face",   tface.dt());
   auto rtvertex = cgal.add_type<RTr_2::Vertex>(rtr_name + "Vertex", tvertex.dt());
 
-  tvertex
-    .method("degree", &Tr_2::Vertex::degree)
-    .method("point", [](const Tr_2::Vertex& v) -> const Tr_2::Point& {
-      return v.point();
-    })
-    ;
+  const std::string dhtr_name = "DelaunayHierarchy2";
+  auto dhtbase   = cgal.add_type<DHTr_2::Triangulation>(dhtr_name + "Base");
+  auto dhtr      = cgal.add_type<DHTr_2>        (dhtr_name, dhtbase.dt());
+  cgal.add_type<DHTr_2::Edge>(dhtr_name + "Edge", tedge.dt());
+  auto dhtface   = cgal.add_type<DHTr_2::Face>  (dhtr_name + "Face",   tface.dt());
+  auto dhtvertex = cgal.add_type<DHTr_2::Vertex>(dhtr_name + "Vertex", tvertex.dt());
 
-  tface
-    .method("dimension", &Tr_2::Face::dimension)
-    .method("is_valid", &Tr_2::Face::is_valid)
-    .method("neighbor", [](const Tr_2::Face& f, const jlcxx::cxxint_t i) {
-      return *f.neighbor(i - 1);
-    })
-    .method("vertex", [](const Tr_2::Face& f, const jlcxx::cxxint_t i) {
-      return *f.vertex(i - 1);
-    })
-    ;
+  const std::string cdhtr_name = "Constrained" + dhtr_name;
+  auto cdhtbase   = cgal.add_type<CDHTr_2::Triangulation>(cdhtr_name + "Base");
+  auto cdhtr      = cgal.add_type<CDHTr_2>        (cdhtr_name, cdhtbase.dt());
+  cgal.add_type<CDHTr_2::Edge>(cdhtr_name + "Edge", ctedge.dt());
+  auto cdhtface   = cgal.add_type<CDHTr_2::Face>  (cdhtr_name + "Face",   ctface.dt());
+  auto cdhtvertex = cgal.add_type<CDHTr_2::Vertex>(cdhtr_name + "Vertex", ctvertex.dt());
+
+  wrap_segment_walker<Tr_2>   (cgal, tr_name);
+  wrap_segment_walker<CTr_2>  (cgal, ctr_name);
+  wrap_segment_walker<RTr_2>  (cgal, rtr_name);
+  wrap_segment_walker<DHTr_2> (cgal, dhtr_name);
+  wrap_segment_walker<CDHTr_2>(cgal, cdhtr_name);
+
+  wrap_vertex_table<DTr_2> (cgal, dtr_name);
+  wrap_vertex_table<DHTr_2>(cgal, dhtr_name);
+
+  tvertex.WRAP_TRIANGULATION_VERTEX(Tr_2::Vertex);
+  tface.WRAP_TRIANGULATION_FACE(Tr_2::Face);
 
   tr
     .WRAP_TRIANGULATION(Tr_2, tr)
@@ -184,6 +535,8 @@ void wrap_triangulation_2(jlcxx::Module& cgal) {
   cdtr
     // Miscellaneous
     .method("is_valid", &CDTr_2::is_valid)
+    // I/O
+    .method("load!", &load_binary<CDTr_2>)
     ;
 
   dtr
@@ -207,26 +560,11 @@ void wrap_triangulation_2(jlcxx::Module& cgal) {
     ;
   cgal.unset_override_module();
   dtr
-    // Queries
-    .method("nearest_vertex", [](const DTr_2& dt, const DTr_2::Point& p) {
-      return *dt.nearest_vertex(p);
-    })
-    // Voronoi Diagram
-    .method("dual", [](const DTr_2& dt, const Tr_2::Edge& e) {
-      auto&& o = dt.dual(e);
-
-      if (const Line_2* l = CGAL::object_cast<Line_2>(&o)) {
-        return (jl_value_t*)jlcxx::box<Line_2>(*l);
-      } else if (const Ray_2* r = CGAL::object_cast<Ray_2>(&o)) {
-        return (jl_value_t*)jlcxx::box<Ray_2>(*r);
-      } else if (const Segment_2* s = CGAL::object_cast<Segment_2>(&o)) {
-        return (jl_value_t*)jlcxx::box<Segment_2>(*s);
-      }
-
-      return jl_nothing; // unreachable
-    })
+    .WRAP_DELAUNAY_TRIANGULATION(DTr_2)
     // Miscellaneous
     .method("is_valid", &DTr_2::is_valid)
+    // I/O
+    .method("load!", &load_binary<DTr_2>)
     ;
 
   rtvertex
@@ -269,8 +607,55 @@ void wrap_triangulation_2(jlcxx::Module& cgal) {
       return jl_nothing; // unreachable
     })
     ;
+
+  dhtvertex.WRAP_TRIANGULATION_VERTEX(DHTr_2::Vertex);
+  dhtface.WRAP_TRIANGULATION_FACE(DHTr_2::Face);
+
+  dhtr
+    .WRAP_TRIANGULATION(DHTr_2, dhtr)
+    .method(dhtr_name, [](jlcxx::ArrayRef<DHTr_2::Point> ps) {
+      return jlcxx::create<DHTr_2>(ps.begin(), ps.end());
+    })
+    .WRAP_DELAUNAY_TRIANGULATION(DHTr_2)
+    ;
+
+  cdhtvertex.WRAP_TRIANGULATION_VERTEX(CDHTr_2::Vertex);
+  cdhtface.WRAP_TRIANGULATION_FACE(CDHTr_2::Face);
+
+  cdhtr
+    .WRAP_TRIANGULATION(CDHTr_2, cdhtr)
+    .method(cdhtr_name, [](jlcxx::ArrayRef<CDHTr_2::Point> ps) {
+      return jlcxx::create<CDHTr_2>(ps.begin(), ps.end());
+    })
+    // Queries
+    .method("is_constrained", [](const CDHTr_2& ct, const CDHTr_2::Edge& e) {
+      return ct.is_constrained(e);
+    })
+    .method("constrained_edges", [](const CDHTr_2& ct) {
+      return collect(ct.constrained_edges_begin(), ct.constrained_edges_end());
+    })
+    // Constraint endpoints go through the hierarchy so that they also make
+    // it to the upper levels.
+    .method("insert_constraint", [](CDHTr_2& ct, const CDHTr_2::Point& p,
+                                                 const CDHTr_2::Point& q) {
+      ct.insert_constraint(ct.insert(p), ct.insert(q));
+    })
+    .method("insert_constraint", [](CDHTr_2& ct,
+                                    jlcxx::ArrayRef<CDHTr_2::Point> ps) {
+      if (ps.size() < 2) return;
+      CDHTr_2::Vertex_handle va = ct.insert(ps[0]);
+      for (std::size_t i = 1; i < ps.size(); ++i) {
+        CDHTr_2::Vertex_handle vb = ct.insert(ps[i], va->face());
+        ct.insert_constraint(va, vb);
+        va = vb;
+      }
+    })
+    ;
 }
 
+#undef WRAP_DELAUNAY_TRIANGULATION
 #undef WRAP_TRIANGULATION
+#undef WRAP_TRIANGULATION_FACE
+#undef WRAP_TRIANGULATION_VERTEX
 
 } // jlcgal
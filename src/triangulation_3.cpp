@@ -0,0 +1,190 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <CGAL/Handle_hash_function.h>
+
+#include <jlcxx/module.hpp>
+
+#include <julia.h>
+
+#include "triangulation_3.hpp"
+#include "utils.hpp"
+
+namespace jlcgal {
+
+// Cells are referred to by their position in the finite cell order, i.e., the
+// order in which `tetrahedra` lists them.
+template<typename T>
+std::unordered_map<typename T::Cell_handle, std::size_t, CGAL::Handle_hash_function>
+cell_indices(const T& t) {
+  std::unordered_map<typename T::Cell_handle, std::size_t,
+                     CGAL::Handle_hash_function> idx;
+  for (auto it = t.finite_cells_begin(); it != t.finite_cells_end(); ++it) {
+    idx.emplace(it, idx.size());
+  }
+  return idx;
+}
+
+// Bulk insertion, which runs concurrently when the triangulation data
+// structure is parallel.  The lock grid only lives for the insertion, so it
+// is detached from the triangulation afterwards, even if insertion throws.
+template<typename T, typename Point>
+void
+insert_points(T& t, const std::vector<Point>& ps) {
+  if (ps.empty()) return;
+#ifdef JLCGAL_PARALLEL
+  Bbox_3 bb = Kernel::Construct_point_3()(ps.front()).bbox();
+  for (const Point& p : ps) bb += Kernel::Construct_point_3()(p).bbox();
+  CGAL::Spatial_lock_grid_3<CGAL::Tag_priority_blocking> lock_ds(bb, 50);
+  struct Lock_detacher {
+    T& t;
+    ~Lock_detacher() { t.set_lock_data_structure(nullptr); }
+  };
+  t.set_lock_data_structure(&lock_ds);
+  const Lock_detacher detacher{t};
+  t.insert(ps.begin(), ps.end());
+#else
+  t.insert(ps.begin(), ps.end());
+#endif
+}
+
+// Runs a hinted query over packed xyz coordinates, returning 1-based indices,
+// 0 standing for "none".  Locating in 3D may draw from the triangulation's
+// random generator, so queries run sequentially, each walking from the
+// previous answer.
+template<typename T, typename Query>
+jlcxx::Array<jlcxx::cxxint_t>
+batch_query(const T& t, jlcxx::ArrayRef<double> xyz, const Query& query) {
+  if (xyz.size() % 3 != 0) {
+    throw std::invalid_argument("coordinates must come in xyz triples");
+  }
+  jlcxx::Array<jlcxx::cxxint_t> jlarr;
+  typename T::Cell_handle hint;
+  for (std::size_t i = 0; i < xyz.size(); i += 3) {
+    jlarr.push_back(query(Point_3(xyz[i], xyz[i + 1], xyz[i + 2]), hint));
+  }
+  return jlarr;
+}
+
+template<typename T>
+void
+wrap_triangulation_3(jlcxx::Module& cgal, const std::string& name) {
+  typedef typename T::Point Point;
+
+  auto tr = cgal.add_type<T>(name)
+    // Creation
+    .template constructor<const T&>()
+    .method(name, [](jlcxx::ArrayRef<Point> ps) {
+      // Owned until boxed, so that a throwing insertion does not leak.
+      std::unique_ptr<T> t(new T);
+      insert_points(*t, std::vector<Point>(ps.begin(), ps.end()));
+      return jlcxx::boxed_cpp_pointer(t.release(), jlcxx::julia_type<T>(), true);
+    })
+    // Access Functions
+    .method("dimension",               &T::dimension)
+    .method("number_of_vertices",      &T::number_of_vertices)
+    .method("number_of_cells",         &T::number_of_cells)
+    .method("number_of_finite_cells",  &T::number_of_finite_cells)
+    // Flat Export, with the vertices as packed xyz coordinates rounded to
+    // doubles, and 1-based indices into them and the finite cells, 0 standing
+    // for an infinite neighbor.  The i-th neighbor of a cell lies opposite to
+    // its i-th vertex.
+    .method("coordinates", [](const T& t) {
+      jlcxx::Array<double> jlarr;
+      for (auto it = t.finite_vertices_begin(); it != t.finite_vertices_end(); ++it) {
+        const Point_3 p = Kernel::Construct_point_3()(it->point());
+        jlarr.push_back(CGAL::to_double(p.x()));
+        jlarr.push_back(CGAL::to_double(p.y()));
+        jlarr.push_back(CGAL::to_double(p.z()));
+      }
+      return jlarr;
+    })
+    .method("tetrahedra", [](const T& t) {
+      auto vidx = vertex_indices(t);
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (auto it = t.finite_cells_begin(); it != t.finite_cells_end(); ++it) {
+        for (int i = 0; i < 4; ++i) jlarr.push_back(vidx[it->vertex(i)] + 1);
+      }
+      return jlarr;
+    })
+    .method("cell_neighbors", [](const T& t) {
+      auto cidx = cell_indices(t);
+      jlcxx::Array<jlcxx::cxxint_t> jlarr;
+      for (auto it = t.finite_cells_begin(); it != t.finite_cells_end(); ++it) {
+        for (int i = 0; i < 4; ++i) {
+          auto n = cidx.find(it->neighbor(i));
+          jlarr.push_back(n != cidx.end() ? n->second + 1 : 0);
+        }
+      }
+      return jlarr;
+    })
+    // Queries, over packed xyz coordinates.  `locate` gives 0 for points
+    // outside the convex hull.
+    .method("locate", [](const T& t, jlcxx::ArrayRef<double> xyz) {
+      auto cidx = cell_indices(t);
+      return batch_query(t, xyz, [&](const Point_3& p,
+                                     typename T::Cell_handle& hint) {
+        hint = t.locate(Point(p), hint);
+        auto c = cidx.find(hint);
+        return static_cast<jlcxx::cxxint_t>(c != cidx.end() ? c->second + 1 : 0);
+      });
+    })
+    // Miscellaneous
+    .method("is_valid", [](const T& t) { return t.is_valid(); })
+    ;
+  cgal.set_override_module(jl_base_module);
+  tr
+    // Insertion and Removal
+    .method("insert!", [](T& t, jlcxx::ArrayRef<Point> ps) -> T& {
+      insert_points(t, std::vector<Point>(ps.begin(), ps.end()));
+      return t;
+    })
+    .method("push!", [](T& t, const Point& p) -> T& {
+      t.insert(p);
+      return t;
+    })
+    .method("empty!", [](T& t) -> T& {
+      t.clear();
+      return t;
+    })
+    ;
+  cgal.unset_override_module();
+}
+
+void wrap_triangulation_3(jlcxx::Module& cgal) {
+  wrap_triangulation_3<DTr_3>(cgal, "DelaunayTriangulation3");
+  wrap_triangulation_3<RTr_3>(cgal, "RegularTriangulation3");
+
+  // Flat Export, in the order of `coordinates`.
+  cgal.method("weights", [](const RTr_3& rt) {
+    jlcxx::Array<double> jlarr;
+    for (auto it = rt.finite_vertices_begin(); it != rt.finite_vertices_end(); ++it) {
+      jlarr.push_back(CGAL::to_double(it->point().weight()));
+    }
+    return jlarr;
+  });
+
+  cgal.method("nearest_vertex", [](const DTr_3& dt, jlcxx::ArrayRef<double> xyz) {
+    auto vidx = vertex_indices(dt);
+    return batch_query(dt, xyz, [&](const Point_3& p, DTr_3::Cell_handle& hint) {
+      auto v = dt.nearest_vertex(p, hint);
+      if (v == DTr_3::Vertex_handle() || dt.is_infinite(v)) return jlcxx::cxxint_t(0);
+      hint = v->cell();
+      return static_cast<jlcxx::cxxint_t>(vidx[v] + 1);
+    });
+  });
+  cgal.method("nearest_power_vertex", [](const RTr_3& rt, jlcxx::ArrayRef<double> xyz) {
+    auto vidx = vertex_indices(rt);
+    return batch_query(rt, xyz, [&](const Point_3& p, RTr_3::Cell_handle& hint) {
+      auto v = rt.nearest_power_vertex(p, hint);
+      if (v == RTr_3::Vertex_handle() || rt.is_infinite(v)) return jlcxx::cxxint_t(0);
+      hint = v->cell();
+      return static_cast<jlcxx::cxxint_t>(vidx[v] + 1);
+    });
+  });
+}
+
+} // jlcgal
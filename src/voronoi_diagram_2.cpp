@@ -1,15 +1,34 @@
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CGAL/Apollonius_graph_adaptation_policies_2.h>
+#include <CGAL/Apollonius_graph_adaptation_traits_2.h>
 #include <CGAL/Delaunay_triangulation_adaptation_policies_2.h>
 #include <CGAL/Delaunay_triangulation_adaptation_traits_2.h>
+#include <CGAL/Identity_policy_2.h>
 #include <CGAL/Regular_triangulation_adaptation_policies_2.h>
 #include <CGAL/Regular_triangulation_adaptation_traits_2.h>
+#include <CGAL/Segment_Delaunay_graph_adaptation_policies_2.h>
+#include <CGAL/Segment_Delaunay_graph_adaptation_traits_2.h>
 #include <CGAL/Voronoi_diagram_2.h>
 
 #include <jlcxx/module.hpp>
+#include <jlcxx/tuple.hpp>
 
 #include <julia.h>
 
+#include "apollonius_graph.hpp"
+#include "parallel.hpp"
+#include "segment_delaunay_graph.hpp"
 #include "triangulation.hpp"
 #include "utils.hpp"
+#include "voronoi_cells.hpp"
 
 namespace jlcxx {
   template<typename DG, typename AT, typename AP>
@@ -30,19 +49,127 @@ using Voronoi_regular_2 = CGAL::Voronoi_diagram_2<RT2
   , CGAL::Regular_triangulation_adaptation_traits_2<RT2>
   , CGAL::Regular_triangulation_caching_degeneracy_removal_policy_2<RT2>>;
 
+template<typename AG2>
+using Voronoi_apollonius_2 = CGAL::Voronoi_diagram_2<AG2
+  , CGAL::Apollonius_graph_adaptation_traits_2<AG2>
+  , CGAL::Apollonius_graph_caching_degeneracy_removal_policy_2<AG2>>;
 
-void wrap_voronoi_diagram_2(jlcxx::Module& cgal) {
+// Points of segment Delaunay graphs are their traits' own, converted from and
+// to the kernel's at the interface.
+template<typename SDG2>
+using Voronoi_segment_delaunay_2 = CGAL::Voronoi_diagram_2<SDG2
+  , CGAL::Segment_Delaunay_graph_adaptation_traits_2<SDG2>
+  , CGAL::Segment_Delaunay_graph_caching_degeneracy_removal_policy_2<SDG2>>;
+
+// Without degeneracy removal, for sites in general position: degenerate
+// inputs yield zero-length edges and vertices of degree above three.
+template<typename DT2>
+using Identity_voronoi_delaunay_2 = CGAL::Voronoi_diagram_2<DT2
+  , CGAL::Delaunay_triangulation_adaptation_traits_2<DT2>
+  , CGAL::Identity_policy_2<DT2
+    , CGAL::Delaunay_triangulation_adaptation_traits_2<DT2>>>;
+
+template<typename RT2>
+using Identity_voronoi_regular_2 = CGAL::Voronoi_diagram_2<RT2
+  , CGAL::Regular_triangulation_adaptation_traits_2<RT2>
+  , CGAL::Identity_policy_2<RT2
+    , CGAL::Regular_triangulation_adaptation_traits_2<RT2>>>;
+
+// Voronoi vertices (the duals of the finite faces, in order) as packed xy
+// coordinates.
+template<typename DG>
+jlcxx::Array<double>
+voronoi_vertices(const DG& dg) {
+  jlcxx::Array<double> jlarr;
+  for (auto it = dg.finite_faces_begin(); it != dg.finite_faces_end(); ++it) {
+    const auto p = dg.dual(it);
+    jlarr.push_back(CGAL::to_double(p.x()));
+    jlarr.push_back(CGAL::to_double(p.y()));
+  }
+  return jlarr;
+}
+
+// Voronoi edges (the duals of the finite edges) clipped to a rectangle, as
+// packed x1, y1, x2, y2 quadruples.  Edges missing the rectangle are skipped.
+template<typename DG>
+jlcxx::Array<double>
+voronoi_edges(const DG& dg, const Iso_rectangle_2& clip) {
+  jlcxx::Array<double> jlarr;
+  auto push_clipped = [&](const auto& e) {
+    auto res = CGAL::intersection(e, clip);
+    if (!res) return;
+    if (const Segment_2* s = boost::get<Segment_2>(&*res)) {
+      jlarr.push_back(CGAL::to_double(s->source().x()));
+      jlarr.push_back(CGAL::to_double(s->source().y()));
+      jlarr.push_back(CGAL::to_double(s->target().x()));
+      jlarr.push_back(CGAL::to_double(s->target().y()));
+    }
+  };
+  for (auto it = dg.finite_edges_begin(); it != dg.finite_edges_end(); ++it) {
+    const CGAL::Object o = dg.dual(*it);
+    if (const Segment_2* s = CGAL::object_cast<Segment_2>(&o)) {
+      push_clipped(*s);
+    } else if (const Ray_2* r = CGAL::object_cast<Ray_2>(&o)) {
+      push_clipped(*r);
+    } else if (const Line_2* l = CGAL::object_cast<Line_2>(&o)) {
+      push_clipped(*l);
+    }
+  }
+  return jlarr;
+}
+
+// Queries answered straight from a triangulation, without building the
+// Voronoi diagram adaptor.
+template<typename DG>
+void
+wrap_dual_queries(jlcxx::Module& cgal) {
+  cgal.method("voronoi_vertices", &voronoi_vertices<DG>);
+  cgal.method("voronoi_edges",    &voronoi_edges<DG>);
+  cgal.method("voronoi_cells", [](const DG& dg, const Iso_rectangle_2& clip) {
+    return pack_cells(clipped_cells(dg, clip));
+  });
+}
+
+// Power cells clipped to a rectangle, packed as by `voronoi_cells`, along
+// with the area and the centroid (as xy pairs) of each cell.
+template<typename DG>
+std::tuple<jlcxx::Array<double>, jlcxx::Array<jlcxx::cxxint_t>,
+           jlcxx::Array<jlcxx::cxxint_t>, jlcxx::Array<double>,
+           jlcxx::Array<double>>
+power_cells(const DG& dg, const Iso_rectangle_2& clip) {
+  const std::vector<Cell_2> cells = clipped_cells(dg, clip);
+  std::vector<double> areas(cells.size());
+  std::vector<Cell_point_2> centroids(cells.size());
+  parallel_for(cells.size(), [&](const std::size_t i) {
+    cell_area_centroid(cells[i], areas[i], centroids[i]);
+  });
+
+  jlcxx::Array<double> jlareas, jlcentroids;
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    if (cells[i].empty()) continue;
+    jlareas.push_back(areas[i]);
+    jlcentroids.push_back(centroids[i][0]);
+    jlcentroids.push_back(centroids[i][1]);
+  }
+  auto packed = pack_cells(cells);
+  return std::make_tuple(std::get<0>(packed), std::get<1>(packed),
+                         std::get<2>(packed), jlareas, jlcentroids);
+}
+
+// Wraps Voronoi diagrams of the given types as the parametric type vd_name,
+// along with its face, halfedge and vertex types.
+template<typename... VDs>
+void
+wrap_voronoi_diagram(jlcxx::Module& cgal, const std::string& vd_name) {
   using jlcxx::Parametric;
   using jlcxx::TypeVar;
 
-  const std::string vd_name = "VoronoiDiagram2";
-
   auto vdface     = cgal.add_type<Parametric<TypeVar<1>>>(vd_name + "Face");
   auto vdhalfedge = cgal.add_type<Parametric<TypeVar<1>>>(vd_name + "Halfedge");
   auto vdvertex   = cgal.add_type<Parametric<TypeVar<1>>>(vd_name + "Vertex");
 
   cgal.add_type<Parametric<TypeVar<1>>>(vd_name)
-    .apply<Voronoi_delaunay_2<DTr_2>, Voronoi_regular_2<RTr_2>>([&](auto vd) {
+    .apply<VDs...>([&](auto vd) {
       typedef typename decltype(vd)::type  VD;
       typedef typename VD::Delaunay_graph  DG;
       typedef typename VD::Face            Face;
@@ -135,7 +262,9 @@ void wrap_voronoi_diagram_2(jlcxx::Module& cgal) {
           // Access Methods
           .method("halfedge", [](const Vertex& v) { return *v.halfedge(); })
           .method("degree", &Vertex::degree)
-          .method("point", &Vertex::point)
+          .method("point", [](const Vertex& v) {
+            return To_linear<Point_2>()(v.point());
+          })
           .method("dual", [](const Vertex& v) { return *v.dual(); })
           .method("site", [](const Vertex& v, const jlcxx::cxxint_t i) {
             return *v.site(i - 1);
@@ -252,8 +381,9 @@ void wrap_voronoi_diagram_2(jlcxx::Module& cgal) {
       cgal.unset_override_module();
       vd
         // Queries
-        .method("locate", [](const VD& vd, const Point_2& p) {
-          return boost::apply_visitor(Handle_visitor(), vd.locate(p));
+        .method("locate", [](const VD& vd, const Kernel::Point_2& p) {
+          return boost::apply_visitor(Handle_visitor(),
+                                      vd.locate(To_sdg<Point_2>()(p)));
         })
         // Validity check
         .method("is_valid", &VD::is_valid)
@@ -261,7 +391,180 @@ void wrap_voronoi_diagram_2(jlcxx::Module& cgal) {
         .method("swap", &VD::swap)
         ;
     });
+}
+
+inline DTr_2::Vertex_handle
+nearest_site(const DTr_2& dt, const Point_2& p, const DTr_2::Vertex_handle hint) {
+  return dt.nearest_vertex(p, hint != nullptr ? hint->face() : DTr_2::Face_handle());
+}
+
+inline RTr_2::Vertex_handle
+nearest_site(const RTr_2& rt, const Point_2& p, const RTr_2::Vertex_handle hint) {
+  return rt.nearest_power_vertex(p, hint != nullptr ? hint->face()
+                                                    : RTr_2::Face_handle());
+}
+
+template<typename AG>
+typename AG::Vertex_handle
+nearest_site(const AG& ag, const Point_2& p, const typename AG::Vertex_handle hint) {
+  return hint != nullptr ? ag.nearest_neighbor(p, hint) : ag.nearest_neighbor(p);
+}
+
+inline CGAL::Comparison_result
+compare_site_distance(const DTr_2&, const Point_2& p,
+                      const DTr_2::Vertex_handle a, const DTr_2::Vertex_handle b) {
+  return CGAL::compare_distance_to_point(p, a->point(), b->point());
+}
+
+inline CGAL::Comparison_result
+compare_site_distance(const RTr_2& rt, const Point_2& p,
+                      const RTr_2::Vertex_handle a, const RTr_2::Vertex_handle b) {
+  return rt.geom_traits().compare_power_distance_2_object()(p, a->point(),
+                                                            b->point());
+}
+
+// Additively weighted distances, |p - c| - w, which involve square roots.
+template<typename AG>
+CGAL::Comparison_result
+compare_site_distance(const AG&, const Point_2& p,
+                      const typename AG::Vertex_handle a,
+                      const typename AG::Vertex_handle b) {
+  const Apollonius_site_2 &sa = a->site(), &sb = b->site();
+  return CGAL::compare(
+    CGAL::sqrt(CGAL::squared_distance(p, sa.point())) - sa.weight(),
+    CGAL::sqrt(CGAL::squared_distance(p, sb.point())) - sb.weight());
+}
+
+// Locates packed xy query points in the Voronoi diagram of a Delaunay graph
+// (a Delaunay or regular triangulation, or an Apollonius graph),
+// returning a kind and a 1-based id per query:
+// - 1 for a face, identified by its site's index in `sites`;
+// - 2 for an edge, identified by its dual edge's index in the finite edges;
+// - 3 for a vertex, identified by its dual face's index in the finite faces;
+// - 0 (with id 0) only if the diagram is empty.
+// Each query takes its closest site, walking from the previous query's, and
+// counts the neighboring sites at the same distance.
+template<typename DG>
+std::tuple<jlcxx::Array<jlcxx::cxxint_t>, jlcxx::Array<jlcxx::cxxint_t>>
+locate_many(const DG& dg, jlcxx::ArrayRef<double> xy) {
+  typedef typename DG::Vertex_handle Vertex_handle;
+  typedef typename DG::Face_handle   Face_handle;
+
+  const std::size_t n = xy.size() / 2, nv = dg.number_of_vertices();
+  auto vidx = vertex_indices(dg);
+  std::map<std::pair<std::size_t, std::size_t>, std::size_t> eidx;
+  auto edge_key = [](const std::size_t a, const std::size_t b) {
+    return std::make_pair(std::min(a, b), std::max(a, b));
+  };
+  for (auto it = dg.finite_edges_begin(); it != dg.finite_edges_end(); ++it) {
+    eidx.emplace(edge_key(vidx[it->first->vertex(DG::ccw(it->second))],
+                          vidx[it->first->vertex(DG::cw(it->second))]),
+                 eidx.size());
+  }
+  std::unordered_map<Face_handle, std::size_t, CGAL::Handle_hash_function> fidx;
+  for (auto it = dg.finite_faces_begin(); it != dg.finite_faces_end(); ++it) {
+    fidx.emplace(it, fidx.size());
+  }
+
+  std::vector<jlcxx::cxxint_t> kinds(n, 0), ids(n, 0);
+  parallel_for_ranges(n, [&](const std::size_t b, const std::size_t e) {
+    Vertex_handle hint;
+    std::vector<Vertex_handle> ties;
+    for (std::size_t i = b; i < e; ++i) {
+      if (nv == 0) continue;
+      const Point_2 p(xy[2 * i], xy[2 * i + 1]);
+      const Vertex_handle v = nearest_site(dg, p, hint);
+      hint = v;
+
+      ties.clear();
+      if (dg.dimension() > 0) {
+        auto vc = dg.incident_vertices(v), done = vc;
+        do {
+          if (!dg.is_infinite(vc) &&
+              compare_site_distance(dg, p, Vertex_handle(vc), v) == CGAL::EQUAL) {
+            ties.push_back(vc);
+          }
+        } while (++vc != done);
+      }
+
+      kinds[i] = 1;
+      ids[i] = vidx.at(v) + 1;
+      if (!ties.empty()) {
+        // Falls back to the edge with the first tie when no finite face is
+        // shared with two ties, as on the hull of cocircular sites.
+        kinds[i] = 2;
+        ids[i] = eidx.at(edge_key(vidx.at(v), vidx.at(ties.front()))) + 1;
+      }
+      if (ties.size() > 1 && dg.dimension() == 2) {
+        auto fc = dg.incident_faces(v), done = fc;
+        do {
+          if (dg.is_infinite(fc)) continue;
+          const int k = fc->index(v);
+          if (std::count(ties.begin(), ties.end(), fc->vertex(DG::ccw(k))) &&
+              std::count(ties.begin(), ties.end(), fc->vertex(DG::cw(k)))) {
+            kinds[i] = 3;
+            ids[i] = fidx.at(fc) + 1;
+            break;
+          }
+        } while (++fc != done);
+      }
+    }
+  });
+
+  return std::make_tuple(collect(kinds.begin(), kinds.end()),
+                         collect(ids.begin(), ids.end()));
+}
+
+template<typename VD>
+void
+wrap_voronoi_batch_queries(jlcxx::Module& cgal) {
+  // Every cell at once, clipped to a rectangle: packed xy coordinates, CSR
+  // offsets into them and the 1-based index of each cell's site in `sites`.
+  cgal.method("voronoi_cells", [](const VD& vd, const Iso_rectangle_2& clip) {
+    return pack_cells(clipped_cells(vd.dual(), clip));
+  });
+  cgal.method("locate_many", [](const VD& vd, jlcxx::ArrayRef<double> xy) {
+    return locate_many(vd.dual(), xy);
+  });
+}
+
+// Apollonius cells are bounded by hyperbolic arcs, sampled until within
+// `tolerance` of the curve.
+template<typename VD>
+void
+wrap_apollonius_batch_queries(jlcxx::Module& cgal) {
+  cgal.method("voronoi_cells", [](const VD& vd, const Iso_rectangle_2& clip,
+                                  const double tolerance) {
+    typedef typename VD::Delaunay_graph AG;
+    return pack_cells(
+      Apollonius_diagram_tracer_2<AG>(vd.dual(), clip, tolerance).cells());
+  });
+  cgal.method("locate_many", [](const VD& vd, jlcxx::ArrayRef<double> xy) {
+    return locate_many(vd.dual(), xy);
+  });
+}
+
+void wrap_voronoi_diagram_2(jlcxx::Module& cgal) {
+  wrap_voronoi_diagram<Voronoi_delaunay_2<DTr_2>,
+                       Voronoi_regular_2<RTr_2>,
+                       Voronoi_apollonius_2<AG_2>,
+                       Voronoi_apollonius_2<AGH_2>,
+                       Voronoi_segment_delaunay_2<SDG_2>,
+                       Voronoi_segment_delaunay_2<SDGH_2>>(cgal, "VoronoiDiagram2");
+  wrap_voronoi_diagram<Identity_voronoi_delaunay_2<DTr_2>,
+                       Identity_voronoi_regular_2<RTr_2>>(cgal, "IdentityVoronoiDiagram2");
+
+  wrap_voronoi_batch_queries<Voronoi_delaunay_2<DTr_2>>(cgal);
+  wrap_voronoi_batch_queries<Voronoi_regular_2<RTr_2>>(cgal);
+  wrap_voronoi_batch_queries<Identity_voronoi_delaunay_2<DTr_2>>(cgal);
+  wrap_voronoi_batch_queries<Identity_voronoi_regular_2<RTr_2>>(cgal);
+  wrap_apollonius_batch_queries<Voronoi_apollonius_2<AG_2>>(cgal);
+  wrap_apollonius_batch_queries<Voronoi_apollonius_2<AGH_2>>(cgal);
+
+  wrap_dual_queries<DTr_2>(cgal);
+  wrap_dual_queries<RTr_2>(cgal);
 
+  cgal.method("power_cells", &power_cells<RTr_2>);
 }
 
 } // jlcgal